@@ -0,0 +1,178 @@
+#include "minishell.h"
+#include "libft.h"
+#include <sched.h>
+
+/**
+ * @brief Add the CPUs of a sysfs cpulist ("0-3,8,10-11") to a set
+ * @param list Text of the cpulist file
+ * @param set CPU set receiving the listed CPUs
+ */
+static void	cpulist_set(const char *list, cpu_set_t *set)
+{
+	int	from;
+	int	to;
+
+	while (ft_isdigit(*list))
+	{
+		from = ft_atoi(list);
+		while (ft_isdigit(*list))
+			list++;
+		to = from;
+		if (*list == '-')
+			to = ft_atoi(++list);
+		while (ft_isdigit(*list))
+			list++;
+		while (from <= to && from < CPU_SETSIZE)
+			CPU_SET(from++, set);
+		if (*list == ',')
+			list++;
+	}
+}
+
+/**
+ * @brief Append the usable CPUs of one NUMA node to the topology
+ * @param topo Topology being built
+ * @param node NUMA node number
+ * @param allowed CPUs the shell may run on
+ *
+ * Nodes that do not exist are skipped; CPUs outside the shell's own
+ * affinity mask (taskset, cgroup cpusets) are never used.
+ */
+static void	topo_node(t_topo *topo, int node, cpu_set_t *allowed)
+{
+	char		path[64];
+	char		list[1024];
+	cpu_set_t	set;
+	char		*num;
+	int			fd;
+	int			cpu;
+	ssize_t		len;
+
+	num = ft_itoa(node);
+	ft_memcpy(path, "/sys/devices/system/node/node", 30);
+	ft_memcpy(path + 29, num, ft_strlen(num) + 1);
+	ft_memcpy(path + ft_strlen(path), "/cpulist", 9);
+	free(num);
+	fd = open(path, O_RDONLY | O_CLOEXEC);
+	if (fd == -1)
+		return ;
+	len = read(fd, list, sizeof(list) - 1);
+	close(fd);
+	if (len <= 0)
+		return ;
+	list[len] = '\0';
+	CPU_ZERO(&set);
+	cpulist_set(list, &set);
+	CPU_AND(&set, &set, allowed);
+	if (CPU_COUNT(&set) == 0)
+		return ;
+	topo->node_start[topo->nnodes++] = topo->ncpu;
+	cpu = 0;
+	while (cpu < CPU_SETSIZE && topo->ncpu < TOPO_CPUS)
+		if (CPU_ISSET(cpu++, &set))
+			topo->cpu[topo->ncpu++] = cpu - 1;
+	topo->node_start[topo->nnodes] = topo->ncpu;
+}
+
+/**
+ * @brief Learn which CPUs the shell may use, grouped by NUMA node
+ * @param topo Topology of the shell, loaded once on first use
+ *
+ * topo->cpu lists CPUs node by node, so neighbours in the array are
+ * sibling cores sharing a node's memory and caches. Without NUMA
+ * information in sysfs every allowed CPU is treated as one node.
+ */
+static void	topo_load(t_topo *topo)
+{
+	cpu_set_t	allowed;
+	int			node;
+
+	CPU_ZERO(&allowed);
+	sched_getaffinity(0, sizeof(allowed), &allowed);
+	node = 0;
+	while (node < TOPO_NODES)
+		topo_node(topo, node++, &allowed);
+	if (topo->ncpu == 0)
+	{
+		topo->node_start[topo->nnodes++] = 0;
+		node = 0;
+		while (node < CPU_SETSIZE && topo->ncpu < TOPO_CPUS)
+			if (CPU_ISSET(node++, &allowed))
+				topo->cpu[topo->ncpu++] = node - 1;
+		topo->node_start[topo->nnodes] = topo->ncpu;
+	}
+}
+
+/**
+ * @brief Choose the CPUs of one pipeline stage
+ * @param t Loaded topology; t->rr is the pipeline's first CPU
+ * @param compact true for `compact`, false for `spread`
+ * @param stage Position of the stage in the pipeline
+ * @param set Receives the CPUs the stage may run on
+ */
+static void	stage_set(t_topo *t, bool compact, int stage, cpu_set_t *set)
+{
+	int	first;
+	int	node;
+	int	n;
+	int	k;
+
+	CPU_ZERO(set);
+	first = t->rr % t->ncpu;
+	node = 0;
+	while (t->node_start[node + 1] <= first)
+		node++;
+	if (!compact)
+		node = (node + stage) % t->nnodes;
+	n = t->node_start[node + 1] - t->node_start[node];
+	if (compact)
+	{
+		k = (first - t->node_start[node] + stage) % n;
+		CPU_SET(t->cpu[t->node_start[node] + k], set);
+		return ;
+	}
+	k = 0;
+	while (k < n)
+		CPU_SET(t->cpu[t->node_start[node] + k++], set);
+}
+
+/**
+ * @brief Pin the stages of the pipeline just launched
+ * @param shell Shell state with the launched command list
+ *
+ * Policy from MINISHELL_AFFINITY (read per pipeline, `off` if unset):
+ *   compact  each stage gets its own core, consecutive stages on
+ *            sibling cores of one NUMA node, so pipe data stays in
+ *            that node's caches and memory
+ *   spread   stage i may run anywhere on the i-th next node, for
+ *            CPU-bound stages that compete more than they talk
+ * The first CPU moves round-robin by the pipeline's length from one
+ * pipeline to the next, so concurrent jobs do not pile onto CPU 0.
+ * Single commands are left to the scheduler. Placement is applied from
+ * the parent with sched_setaffinity(pid) as soon as the stages are
+ * launched, so it covers forked, spawned and splice stages alike.
+ */
+void	place_pipeline(t_shell *shell)
+{
+	t_cmds		*curr;
+	cpu_set_t	set;
+	char		*mode;
+	int			i;
+
+	mode = env_get(shell, "MINISHELL_AFFINITY");
+	if (!mode || !shell->cmds->next || (ft_strncmp(mode, "compact", 8) != 0
+			&& ft_strncmp(mode, "spread", 7) != 0))
+		return ;
+	if (shell->topo.ncpu == 0)
+		topo_load(&shell->topo);
+	curr = shell->cmds;
+	i = 0;
+	while (curr)
+	{
+		stage_set(&shell->topo, mode[0] == 'c', i++, &set);
+		if (curr->pid > 0)
+			sched_setaffinity(curr->pid, sizeof(set), &set);
+		curr = curr->next;
+	}
+	shell->topo.rr += i;
+}
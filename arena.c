@@ -0,0 +1,124 @@
+#include "minishell.h"
+#include "libft.h"
+
+/**
+ * @brief Allocate a new arena chunk and append it to the chunk list
+ * @param arena Arena to grow
+ * @param size Minimum usable size of the chunk
+ * @return The new chunk (allocated through ft_malloc)
+ */
+static t_chunk	*new_chunk(t_arena *arena, size_t size)
+{
+	t_chunk	*chunk;
+	t_chunk	**last;
+
+	if (size < ARENA_CHUNK)
+		size = ARENA_CHUNK;
+	chunk = ft_malloc(sizeof(t_chunk) + size);
+	chunk->next = NULL;
+	chunk->size = size;
+	chunk->used = 0;
+	last = &arena->head;
+	while (*last)
+		last = &(*last)->next;
+	*last = chunk;
+	return (chunk);
+}
+
+/**
+ * @brief Allocate memory that lives until the next arena_reset()
+ * @param arena Per-command-line arena of the shell
+ * @param size Number of bytes needed
+ * @return Pointer aligned to 16 bytes; never NULL (ft_malloc exits)
+ *
+ * A pointer bump in the current chunk; chunks are kept across resets,
+ * so a warmed-up shell never calls malloc() for arena allocations.
+ * Memory from the arena must never be passed to free().
+ */
+void	*arena_alloc(t_arena *arena, size_t size)
+{
+	void	*ptr;
+
+	size = (size + 15) & ~(size_t)15;
+	if (!arena->cur)
+		arena->cur = arena->head;
+	while (arena->cur && arena->cur->used + size > arena->cur->size)
+		arena->cur = arena->cur->next;
+	if (!arena->cur)
+		arena->cur = new_chunk(arena, size);
+	ptr = arena->cur->data + arena->cur->used;
+	arena->cur->used += size;
+	arena->used += size;
+	if (arena->used > arena->peak)
+		arena->peak = arena->used;
+	return (ptr);
+}
+
+/**
+ * @brief Build "dir/name" in the arena
+ * @param arena Per-command-line arena of the shell
+ * @param dir Directory part
+ * @param name File name part
+ * @return The joined path, valid until the next arena_reset()
+ */
+char	*arena_path(t_arena *arena, const char *dir, const char *name)
+{
+	size_t	dlen;
+	size_t	nlen;
+	char	*path;
+
+	dlen = ft_strlen(dir);
+	nlen = ft_strlen(name);
+	path = arena_alloc(arena, dlen + nlen + 2);
+	ft_memcpy(path, dir, dlen);
+	path[dlen] = '/';
+	ft_memcpy(path + dlen + 1, name, nlen + 1);
+	return (path);
+}
+
+/**
+ * @brief Release every arena allocation of the previous command line
+ * @param shell Shell state owning the arena
+ *
+ * Called once per prompt iteration (start of execute). Chunks are kept
+ * for the next line, so this is a walk over a handful of chunks.
+ * With MINISHELL_ARENA_STATS set, every new high-water mark is printed
+ * to stderr to help sizing ARENA_CHUNK.
+ */
+void	arena_reset(t_shell *shell)
+{
+	t_chunk	*chunk;
+
+	if (shell->arena.peak > shell->arena.reported
+		&& env_get(shell, "MINISHELL_ARENA_STATS"))
+	{
+		diag("minishell: arena: peak %ld bytes\n", (long)shell->arena.peak);
+		shell->arena.reported = shell->arena.peak;
+	}
+	chunk = shell->arena.head;
+	while (chunk)
+	{
+		chunk->used = 0;
+		chunk = chunk->next;
+	}
+	shell->arena.cur = shell->arena.head;
+	shell->arena.used = 0;
+}
+
+/**
+ * @brief Free every chunk of the arena (shell exit)
+ * @param arena Arena to destroy
+ */
+void	arena_destroy(t_arena *arena)
+{
+	t_chunk	*next;
+
+	while (arena->head)
+	{
+		next = arena->head->next;
+		free(arena->head);
+		arena->head = next;
+	}
+	arena->cur = NULL;
+	arena->used = 0;
+}
@@ -0,0 +1,173 @@
+#include "minishell.h"
+#include "libft.h"
+#include <errno.h>
+#include <stdint.h>
+#include <string.h>
+#include <sys/stat.h>
+
+/**
+ * @brief Read a whole script into memory
+ * @param fd Open script file
+ * @return Allocated NUL-terminated contents, or NULL on read error
+ *
+ * Regular files are read with a single read() sized from fstat(), and
+ * reading stops once st_size bytes are in: no EOF probe, no regrowth.
+ * The buffer only grows for pipes and other streams of unknown size.
+ */
+static char	*read_script(int fd)
+{
+	struct stat	st;
+	char		*buf;
+	char		*tmp;
+	size_t		cap;
+	size_t		len;
+	size_t		size;
+	ssize_t		n;
+
+	cap = 4096;
+	size = SIZE_MAX;
+	if (fstat(fd, &st) == 0 && S_ISREG(st.st_mode))
+	{
+		size = st.st_size;
+		cap = size + 1;
+	}
+	buf = ft_malloc(cap);
+	len = 0;
+	n = 1;
+	while (n > 0 && len < size)
+	{
+		if (len + 1 == cap)
+		{
+			tmp = ft_malloc(cap * 2);
+			ft_memcpy(tmp, buf, len);
+			free(buf);
+			buf = tmp;
+			cap *= 2;
+		}
+		n = read(fd, buf + len, cap - len - 1);
+		if (n > 0)
+			len += n;
+		else if (n == -1 && errno == EINTR)
+			n = 1;
+	}
+	buf[len] = '\0';
+	if (n == -1)
+	{
+		free(buf);
+		return (NULL);
+	}
+	return (buf);
+}
+
+/**
+ * @brief Check whether a script has commands left after this line
+ * @param rest Text following the current line, or NULL at the end
+ * @return true if a line other than blanks and comments follows
+ *
+ * Stops at the first command character, so the scan is short unless
+ * the script ends in a long run of comments.
+ */
+static bool	more_lines(const char *rest)
+{
+	while (rest && *rest)
+	{
+		while (*rest == ' ' || *rest == '\t' || *rest == '\n')
+			rest++;
+		if (*rest && *rest != '#')
+			return (true);
+		rest = ft_strchr(rest, '\n');
+	}
+	return (false);
+}
+
+/**
+ * @brief Execute every line of an in-memory script, in order
+ * @param shell Shell state used for parsing and execution
+ * @param buf Script contents (modified: newlines become NULs)
+ *
+ * Each line goes straight to the parser and execute(): no readline,
+ * history or prompt rendering. Lines are parsed one at a time rather
+ * than all up front, because parsing expands variables that earlier
+ * lines may still change. Blank lines and comments (including a #!
+ * line) are skipped. Stops early when a child was interrupted.
+ * A lone external command on the last line is exec'd in place of the
+ * shell (see tail_exec).
+ */
+static void	run_lines(t_shell *shell, char *buf)
+{
+	char	*line;
+	char	*nl;
+
+	line = buf;
+	while (line && *line && !shell->stop)
+	{
+		nl = ft_strchr(line, '\n');
+		if (nl)
+			*nl = '\0';
+		while (*line == ' ' || *line == '\t')
+			line++;
+		shell->stamp[TR_PARSE] = trace_now(shell);
+		if (*line && *line != '#' && parse_line(shell, line))
+		{
+			if ((nl && more_lines(nl + 1)) || !tail_exec(shell))
+				execute(shell);
+			free_cmds(shell);
+		}
+		line = NULL;
+		if (nl)
+			line = nl + 1;
+	}
+}
+
+/**
+ * @brief Print a batch-mode startup error and return its exit status
+ * @param what Operand or option the error is about
+ * @param reason Error message
+ * @param status Exit status to return
+ * @return status
+ */
+static int	batch_error(const char *what, const char *reason, int status)
+{
+	diag("minishell: %s: %s\n", what, reason);
+	return (status);
+}
+
+/**
+ * @brief Run minishell non-interactively when main() was given operands
+ * @param shell Initialized shell state (environment already loaded)
+ * @param ac Argument count of main()
+ * @param av Argument vector of main()
+ * @return Exit status of the last command, or -1 for interactive mode
+ *
+ * Usage:
+ *   minishell -c 'command line'   -> run the string as a script
+ *   minishell script.sh           -> run the file, read in one go
+ *   minishell                     -> interactive (returns -1)
+ */
+int	run_batch(t_shell *shell, int ac, char **av)
+{
+	char	*buf;
+	int		fd;
+
+	if (ac < 2)
+		return (-1);
+	if (ft_strncmp(av[1], "-c", 3) == 0)
+	{
+		if (ac < 3)
+			return (batch_error("-c", "option requires an argument", 2));
+		buf = ft_strdup(av[2]);
+	}
+	else
+	{
+		fd = open(av[1], O_RDONLY | O_CLOEXEC);
+		if (fd == -1)
+			return (batch_error(av[1], strerror(errno), 127));
+		buf = read_script(fd);
+		close(fd);
+		if (!buf)
+			return (batch_error(av[1], strerror(errno), 126));
+	}
+	run_lines(shell, buf);
+	free(buf);
+	return (g_return_value);
+}
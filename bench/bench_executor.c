@@ -0,0 +1,275 @@
+#include "minishell.h"
+#include "libft.h"
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <time.h>
+
+/*
+ * Executor benchmarks. Build with every shell object except main.o and
+ * run as `bench_executor [iterations] [bytes]`. Results go to stdout,
+ * one JSON object per line, for example
+ *   {"bench":"spawn_true","iters":1000,"ns_per_op":412345}
+ * Commands under test write to /dev/null. throughput_yes_head_bigpipe
+ * repeats the throughput run under `shopt -s bigpipe`.
+ */
+
+int	g_return_value;
+
+/**
+ * @brief Read the monotonic clock
+ * @return Current time in nanoseconds
+ */
+static long	now_ns(void)
+{
+	struct timespec	ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (ts.tv_sec * 1000000000L + ts.tv_nsec);
+}
+
+/**
+ * @brief Build a synthetic command list, as the parser would
+ * @param line Words separated by spaces, stages separated by '|'
+ * @return Allocated command list (no redirections)
+ */
+static t_cmds	*bench_cmds(const char *line)
+{
+	char	**stages;
+	t_cmds	*head;
+	t_cmds	**tail;
+	int		i;
+
+	stages = ft_split(line, '|');
+	head = NULL;
+	tail = &head;
+	i = 0;
+	while (stages[i])
+	{
+		*tail = ft_calloc(1, sizeof(t_cmds));
+		(*tail)->str = ft_split(stages[i++], ' ');
+		(*tail)->pipefd[0] = -1;
+		(*tail)->pipefd[1] = -1;
+		tail = &(*tail)->next;
+	}
+	ft_free_arr(stages);
+	return (head);
+}
+
+/**
+ * @brief Free a command list made by bench_cmds()
+ * @param cmds Command list (paths belong to the hash table)
+ */
+static void	bench_free(t_cmds *cmds)
+{
+	t_cmds	*next;
+
+	while (cmds)
+	{
+		next = cmds->next;
+		ft_free_arr(cmds->str);
+		free(cmds);
+		cmds = next;
+	}
+}
+
+/**
+ * @brief Print one result line
+ * @param out Buffer writing to the real stdout
+ * @param name Benchmark name
+ * @param iters Number of operations measured
+ * @param ns Total time of all operations, or -1 if the benchmark could
+ *        not run (nothing is printed then)
+ * @param bytes Bytes moved per operation, or 0 for latency benchmarks
+ */
+static void	report(t_outbuf *out, const char *name, long iters, long ns,
+		long bytes)
+{
+	if (ns < 0)
+		return ;
+	if (ns == 0)
+		ns = 1;
+	out_puts(out, "{\"bench\":\"");
+	out_puts(out, name);
+	out_puts(out, "\",\"iters\":");
+	out_putnbr(out, iters, 0);
+	out_puts(out, ",\"ns_per_op\":");
+	out_putnbr(out, ns / iters, 0);
+	if (bytes)
+	{
+		out_puts(out, ",\"bytes_per_sec\":");
+		out_putnbr(out, (unsigned long)(bytes * (iters * 1e9 / ns)), 0);
+	}
+	out_puts(out, "}\n");
+	out_flush(out);
+}
+
+/**
+ * @brief Time execute() on a freshly built command list
+ * @param shell Initialized shell
+ * @param line Pipeline to run (see bench_cmds())
+ * @param iters Number of runs
+ * @return Total nanoseconds spent inside execute()
+ */
+static long	bench_line(t_shell *shell, const char *line, long iters)
+{
+	long	total;
+	long	start;
+
+	total = 0;
+	while (iters-- > 0)
+	{
+		shell->cmds = bench_cmds(line);
+		shell->stop = false;
+		start = now_ns();
+		execute(shell);
+		total += now_ns() - start;
+		bench_free(shell->cmds);
+		shell->cmds = NULL;
+	}
+	return (total);
+}
+
+/**
+ * @brief Time repeated dispatch of one built-in, without any I/O
+ * @param shell Initialized shell
+ * @param iters Number of calls
+ * @return Total nanoseconds spent in execute_builtin()
+ */
+static long	bench_builtin(t_shell *shell, long iters)
+{
+	long	start;
+	long	total;
+
+	shell->cmds = bench_cmds("echo -n");
+	resolve_cmds(shell);
+	start = now_ns();
+	while (iters-- > 0)
+		execute_builtin(shell->cmds, shell);
+	total = now_ns() - start;
+	bench_free(shell->cmds);
+	shell->cmds = NULL;
+	return (total);
+}
+
+/**
+ * @brief Name the i-th scratch PATH directory
+ * @param root Scratch directory made by bench_path()
+ * @param i Directory number
+ * @return Allocated "root/d<i>"
+ */
+static char	*bench_dir(const char *root, int i)
+{
+	char	*num;
+	char	*dir;
+
+	num = ft_itoa(i);
+	dir = ft_strjoin_free(ft_strjoin(root, "/d"), num);
+	free(num);
+	return (dir);
+}
+
+/**
+ * @brief Time cold PATH resolution against a PATH of n directories
+ * @param shell Initialized shell
+ * @param n Number of PATH entries; the command is only in the last one
+ * @param iters Number of lookups (the hash table is cleared each time)
+ * @return Total nanoseconds, or -1 if the directories could not be made
+ *
+ * The shell's PATH is put back afterwards, so later cases do not
+ * search the removed directories.
+ */
+static long	bench_path(t_shell *shell, int n, long iters)
+{
+	char	root[] = "/tmp/msh-bench-XXXXXX";
+	char	*saved;
+	char	*path;
+	char	*dir;
+	long	start;
+	int		i;
+
+	if (!mkdtemp(root))
+		return (-1);
+	saved = env_get(shell, "PATH");
+	if (saved)
+		saved = ft_strdup(saved);
+	path = ft_strdup("");
+	i = 0;
+	while (++i < n)
+	{
+		dir = bench_dir(root, i);
+		mkdir(dir, 0700);
+		path = ft_strjoin_free(ft_strjoin_free(path, dir), ":");
+		free(dir);
+	}
+	path = ft_strjoin_free(path, "/usr/bin");
+	env_set(shell, "PATH", path);
+	start = now_ns();
+	i = 0;
+	while (i++ < iters)
+	{
+		hash_clear(shell);
+		find_in_path(shell, "true");
+		arena_reset(shell);
+	}
+	start = now_ns() - start;
+	while (--n > 0)
+	{
+		dir = bench_dir(root, n);
+		rmdir(dir);
+		free(dir);
+	}
+	rmdir(root);
+	free(path);
+	if (saved)
+		env_set(shell, "PATH", saved);
+	else
+		env_unset(shell, "PATH");
+	free(saved);
+	return (start);
+}
+
+int	main(int ac, char **av, char **envp)
+{
+	static t_shell	shell;
+	t_outbuf		out;
+	long			iters;
+	long			bytes;
+	char			*line;
+	char			*num;
+
+	shell_init(&shell, 1, av, envp);
+	out.len = 0;
+	out.fd = ft_dup(STDOUT);
+	out.sink = NULL;
+	ft_dup2(open("/dev/null", O_WRONLY), STDOUT);
+	iters = 1000;
+	if (ac > 1)
+		iters = ft_atoi(av[1]);
+	if (iters < 1)
+		iters = 1;
+	bytes = 1L << 30;
+	if (ac > 2)
+		bytes = ft_atoi(av[2]);
+	report(&out, "spawn_true", iters, bench_line(&shell, "true", iters), 0);
+	report(&out, "pipeline_2", iters / 4 + 1, bench_line(&shell,
+			"true|true", iters / 4 + 1), 0);
+	report(&out, "pipeline_8", iters / 16 + 1, bench_line(&shell,
+			"true|true|true|true|true|true|true|true", iters / 16 + 1), 0);
+	num = ft_itoa(bytes);
+	line = ft_strjoin("yes|head -c ", num);
+	free(num);
+	shell.opts &= ~OPT_BIGPIPE;
+	report(&out, "throughput_yes_head", 1, bench_line(&shell, line, 1),
+		bytes);
+	shell.opts |= OPT_BIGPIPE;
+	report(&out, "throughput_yes_head_bigpipe", 1, bench_line(&shell, line,
+			1), bytes);
+	shell.opts &= ~OPT_BIGPIPE;
+	free(line);
+	report(&out, "builtin_echo", iters * 100, bench_builtin(&shell,
+			iters * 100), 0);
+	report(&out, "path_5", iters, bench_path(&shell, 5, iters), 0);
+	report(&out, "path_50", iters, bench_path(&shell, 50, iters), 0);
+	report(&out, "path_500", iters, bench_path(&shell, 500, iters), 0);
+	return (0);
+}
@@ -0,0 +1,98 @@
+#include "minishell.h"
+#include "libft.h"
+
+/**
+ * @brief Map a command name to its candidate built-in id
+ * @param name Command name
+ * @param len Length of the name
+ * @return Only possible built-in id for this length and first letter
+ *
+ * Perfect hash on (length, first character), looking at one more
+ * letter for the 4-letter e* names: at most one built-in can match,
+ * so builtin_id() needs a single string comparison to confirm.
+ * A new built-in needs its entry in run_builtin() and a case here.
+ */
+static int	builtin_slot(const char *name, size_t len)
+{
+	if (len == 2 && name[0] == 'c')
+		return (BI_CD);
+	if (len == 2 && name[0] == 'f')
+		return (BI_FG);
+	if (len == 3 && name[0] == 'p')
+		return (BI_PWD);
+	if (len == 3 && name[0] == 'e')
+		return (BI_ENV);
+	if (len == 4 && name[0] == 'e' && name[1] == 'c')
+		return (BI_ECHO);
+	if (len == 4 && name[0] == 'e' && name[2] == 'e')
+		return (BI_EXEC);
+	if (len == 4 && name[0] == 'e')
+		return (BI_EXIT);
+	if (len == 4 && name[0] == 'h')
+		return (BI_HASH);
+	if (len == 4 && name[0] == 'j')
+		return (BI_JOBS);
+	if (len == 4 && name[0] == 'r')
+		return (BI_READ);
+	if (len == 4 && name[0] == 'w')
+		return (BI_WAIT);
+	if (len == 5 && name[0] == 'u')
+		return (BI_UNSET);
+	if (len == 5 && name[0] == 's')
+		return (BI_SHOPT);
+	if (len == 6 && name[0] == 'e')
+		return (BI_EXPORT);
+	return (BI_NONE);
+}
+
+/**
+ * @brief Get the name of a built-in from its id
+ * @param id Built-in id (BI_NONE < id < BI_COUNT)
+ * @return Name of the built-in as typed by the user
+ */
+const char	*builtin_name(int id)
+{
+	static const char	*names[BI_COUNT] = {NULL, "pwd", "echo", "cd",
+		"export", "unset", "env", "exit", "hash", "shopt", "jobs", "wait",
+		"fg", "read", "exec"};
+
+	return (names[id]);
+}
+
+/**
+ * @brief Identify the built-in designated by a command name
+ * @param name Command name (may be NULL for redirection-only commands)
+ * @return Built-in id, or BI_NONE if the name is not a built-in
+ *
+ * Called once per command by resolve_cmds(); afterwards the executor
+ * only looks at cmd->builtin and never compares strings again.
+ */
+int	builtin_id(const char *name)
+{
+	size_t	len;
+	int		id;
+
+	if (!name)
+		return (BI_NONE);
+	len = ft_strlen(name);
+	id = builtin_slot(name, len);
+	if (id != BI_NONE && ft_strncmp(name, builtin_name(id), len + 1) != 0)
+		return (BI_NONE);
+	return (id);
+}
+
+/**
+ * @brief Dispatch a tagged command to its built-in implementation
+ * @param cmd Command structure tagged by builtin_id()
+ * @param shell Shell state passed to the built-in
+ * @return Exit status of the built-in
+ */
+int	run_builtin(t_cmds *cmd, t_shell *shell)
+{
+	static int	(*const table[BI_COUNT])(t_cmds *, t_shell *) = {NULL,
+		ft_pwd, ft_echo, ft_cd, bi_export, ft_unset, bi_env, bi_exit,
+		ft_hash, ft_shopt, ft_jobs, ft_wait, ft_fg,
+		ft_read, ft_exec};
+
+	return (table[cmd->builtin](cmd, shell));
+}
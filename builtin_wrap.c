@@ -0,0 +1,37 @@
+#include "minishell.h"
+#include "libft.h"
+
+/**
+ * @brief Dispatch-table adapter for export
+ * @param cmd Command structure containing arguments
+ * @param shell Shell state holding the environment
+ * @return Exit status of ft_export
+ */
+int	bi_export(t_cmds *cmd, t_shell *shell)
+{
+	return (ft_export(cmd, shell, 0));
+}
+
+/**
+ * @brief Dispatch-table adapter for env
+ * @param cmd Command structure (unused, env takes no arguments)
+ * @param shell Shell state holding the environment
+ * @return Exit status of ft_env
+ */
+int	bi_env(t_cmds *cmd, t_shell *shell)
+{
+	(void)cmd;
+	return (ft_env(env_envp(shell)));
+}
+
+/**
+ * @brief Dispatch-table adapter for exit
+ * @param cmd Command structure containing the optional status
+ * @param shell Shell state (flushed before the shell goes away)
+ * @return Exit status of ft_exit when it does not exit
+ */
+int	bi_exit(t_cmds *cmd, t_shell *shell)
+{
+	out_flush(&shell->out);
+	return (ft_exit(cmd));
+}
@@ -0,0 +1,155 @@
+#include "minishell.h"
+#include "libft.h"
+#include <errno.h>
+#include <poll.h>
+
+/**
+ * @brief Append bytes to a capture buffer
+ * @param sink Growable buffer (zero-initialized at start)
+ * @param data Bytes to append
+ * @param len Number of bytes
+ *
+ * Same doubling as heredoc_append(), so capturing n bytes costs
+ * O(log n) allocations. The buffer stays NUL-terminated.
+ */
+void	capture_append(t_heredoc *sink, const char *data, size_t len)
+{
+	char	*grown;
+
+	if (sink->len + len + 1 > sink->cap)
+	{
+		sink->cap = sink->cap * 2 + len + 1;
+		grown = ft_malloc(sink->cap);
+		if (sink->buf)
+			ft_memcpy(grown, sink->buf, sink->len);
+		free(sink->buf);
+		sink->buf = grown;
+	}
+	ft_memcpy(sink->buf + sink->len, data, len);
+	sink->len += len;
+	sink->buf[sink->len] = '\0';
+}
+
+/**
+ * @brief Read a pipe until EOF into a capture buffer
+ * @param fd Read end of the capture pipe
+ * @param sink Buffer receiving everything written to the pipe
+ *
+ * poll() waits for data, then each read() takes up to 64KiB at once,
+ * never one byte at a time. Signals restart both calls.
+ */
+static void	drain(int fd, t_heredoc *sink)
+{
+	struct pollfd	pfd;
+	char			chunk[65536];
+	ssize_t			n;
+
+	pfd.fd = fd;
+	pfd.events = POLLIN;
+	n = 1;
+	while (n != 0)
+	{
+		if (poll(&pfd, 1, -1) == -1)
+		{
+			if (errno == EINTR)
+				continue ;
+			break ;
+		}
+		n = read(fd, chunk, sizeof(chunk));
+		if (n > 0)
+			capture_append(sink, chunk, n);
+		else if (n == -1 && errno != EINTR)
+			break ;
+	}
+}
+
+/**
+ * @brief Check whether a substitution can run in the shell process
+ * @param cmds Resolved command list of the substitution
+ * @return true for a lone echo or pwd without redirections
+ *
+ * Only built-ins that print through shell->out and change no shell
+ * state qualify: `$(cd /tmp)` or `$(export A=1)` must not affect the
+ * shell, so everything else runs in a subshell.
+ */
+static bool	in_process(t_cmds *cmds)
+{
+	return (!cmds->next && !has_redirections(cmds)
+		&& (cmds->builtin == BI_ECHO || cmds->builtin == BI_PWD));
+}
+
+/**
+ * @brief Run the command list in a subshell writing into a pipe
+ * @param shell Shell state with shell->cmds set to the substitution
+ * @param sink Buffer receiving the subshell's stdout
+ *
+ * The child forgets the parent's job table first: execute() starts by
+ * reaping and reporting finished jobs, and those "[n] Done" notices
+ * would otherwise end up inside the substituted text.
+ */
+static void	run_subshell(t_shell *shell, t_heredoc *sink)
+{
+	int		fd[2];
+	int		status;
+	pid_t	pid;
+	pid_t	ret;
+
+	ft_pipe(fd, 0);
+	pid = ft_fork();
+	if (pid == 0)
+	{
+		close(fd[0]);
+		ft_dup2(fd[1], STDOUT);
+		while (shell->jobs)
+			job_remove(shell, shell->jobs);
+		execute(shell);
+		exit(g_return_value);
+	}
+	close(fd[1]);
+	drain(fd[0], sink);
+	close(fd[0]);
+	ret = waitpid(pid, &status, 0);
+	while (ret == -1 && errno == EINTR)
+		ret = waitpid(pid, &status, 0);
+	g_return_value = wait_status(status);
+}
+
+/**
+ * @brief Run a command list and capture its standard output
+ * @param shell Shell state for environment and configuration
+ * @param cmds Parsed command list of the substitution
+ * @return Allocated output with trailing newlines removed, as $(...)
+ *         expands; g_return_value holds the substitution's status
+ *
+ * A lone echo or pwd runs in-process through execute_builtin(), with
+ * shell->out pointed at the capture buffer: no pipe, no fork. Anything
+ * else runs in a subshell whose stdout is a pipe the shell drains with
+ * poll() while it runs, so no temp file is ever involved and output
+ * larger than the pipe buffer cannot deadlock the subshell.
+ * The caller keeps ownership of cmds.
+ */
+char	*capture(t_shell *shell, t_cmds *cmds)
+{
+	t_heredoc	sink;
+	t_cmds		*outer;
+
+	ft_bzero(&sink, sizeof(sink));
+	outer = shell->cmds;
+	shell->cmds = cmds;
+	resolve_cmds(shell);
+	if (in_process(cmds))
+	{
+		out_flush(&shell->out);
+		shell->out.sink = &sink;
+		execute_builtin(cmds, shell);
+		shell->out.sink = NULL;
+	}
+	else
+		run_subshell(shell, &sink);
+	shell->cmds = outer;
+	while (sink.len > 0 && sink.buf[sink.len - 1] == '\n')
+		sink.buf[--sink.len] = '\0';
+	if (!sink.buf)
+		return (ft_strdup(""));
+	return (sink.buf);
+}
@@ -0,0 +1,133 @@
+#include "minishell.h"
+#include "libft.h"
+#include <errno.h>
+#include <stdarg.h>
+#include <string.h>
+
+/**
+ * @brief Append a string to a diagnostic being built
+ * @param buf Message buffer (DIAG_SIZE bytes)
+ * @param len Length used so far (updated)
+ * @param s String to append, truncated when the buffer is full
+ */
+static void	diag_puts(char *buf, size_t *len, const char *s)
+{
+	while (s && *s && *len < DIAG_SIZE)
+		buf[(*len)++] = *s++;
+}
+
+/**
+ * @brief Append a decimal number to a diagnostic being built
+ * @param buf Message buffer
+ * @param len Length used so far (updated)
+ * @param n Number to append
+ */
+static void	diag_putnbr(char *buf, size_t *len, long n)
+{
+	char			digits[24];
+	int				i;
+	unsigned long	u;
+
+	u = n;
+	if (n < 0)
+	{
+		diag_puts(buf, len, "-");
+		u = -(unsigned long)n;
+	}
+	i = sizeof(digits) - 1;
+	digits[i] = '\0';
+	while (i == (int)sizeof(digits) - 1 || u > 0)
+	{
+		digits[--i] = '0' + u % 10;
+		u /= 10;
+	}
+	diag_puts(buf, len, digits + i);
+}
+
+/**
+ * @brief Append a duration in bash `time` format ("0m0.003s")
+ * @param buf Message buffer
+ * @param len Length used so far (updated)
+ * @param usec Duration in microseconds
+ */
+static void	diag_time(char *buf, size_t *len, long usec)
+{
+	char	ms[5];
+
+	diag_putnbr(buf, len, usec / 60000000);
+	diag_puts(buf, len, "m");
+	diag_putnbr(buf, len, usec / 1000000 % 60);
+	ms[0] = '.';
+	ms[1] = '0' + usec / 100000 % 10;
+	ms[2] = '0' + usec / 10000 % 10;
+	ms[3] = '0' + usec / 1000 % 10;
+	ms[4] = '\0';
+	diag_puts(buf, len, ms);
+	diag_puts(buf, len, "s");
+}
+
+/**
+ * @brief Expand one conversion of a diagnostic format
+ * @param buf Message buffer
+ * @param len Length used so far (updated)
+ * @param fmt Format, just past the '%'
+ * @param ap Arguments of diag()
+ * @return Format position after the conversion
+ */
+static const char	*diag_conv(char *buf, size_t *len, const char *fmt,
+		va_list *ap)
+{
+	if (*fmt == 's')
+		diag_puts(buf, len, va_arg(*ap, const char *));
+	else if (*fmt == 'd')
+		diag_putnbr(buf, len, va_arg(*ap, int));
+	else if (*fmt == 'l' && fmt[1] == 'd')
+		diag_putnbr(buf, len, va_arg(*ap, long));
+	else if (*fmt == 'T')
+		diag_time(buf, len, va_arg(*ap, long));
+	else if (*fmt == 'm')
+		diag_puts(buf, len, strerror(errno));
+	else if (*fmt == '%')
+		diag_puts(buf, len, "%");
+	if (*fmt == 'l' && fmt[1] == 'd')
+		fmt++;
+	if (*fmt)
+		fmt++;
+	return (fmt);
+}
+
+/**
+ * @brief Print a diagnostic on stderr with a single write()
+ * @param fmt Format: %s string, %d int, %ld long, %m strerror(errno),
+ *            %T microseconds as "0m0.000s", %% a percent sign
+ *
+ * The message is built in a stack buffer of DIAG_SIZE (PIPE_BUF)
+ * bytes, so it reaches stderr in one piece: it costs one syscall and
+ * never interleaves with what concurrent pipeline stages write there.
+ * Longer messages are truncated. errno is preserved for the caller.
+ *
+ * Example: diag("minishell: %s: %m\n", cmd->str[0]);
+ */
+void	diag(const char *fmt, ...)
+{
+	char	buf[DIAG_SIZE];
+	size_t	len;
+	int		saved;
+	va_list	ap;
+
+	saved = errno;
+	len = 0;
+	va_start(ap, fmt);
+	while (*fmt)
+	{
+		if (*fmt == '%')
+			fmt = diag_conv(buf, &len, fmt + 1, &ap);
+		else if (len < DIAG_SIZE)
+			buf[len++] = *fmt++;
+		else
+			fmt++;
+	}
+	va_end(ap);
+	write(STDERR, buf, len);
+	errno = saved;
+}
@@ -0,0 +1,104 @@
+#include "minishell.h"
+#include "libft.h"
+
+/**
+ * @brief Compute the bucket index of a variable name (djb2)
+ * @param key Variable name (not necessarily NUL-terminated)
+ * @param len Length of the name
+ * @return Bucket index in the range [0, ENV_BUCKETS)
+ */
+unsigned int	env_hash(const char *key, size_t len)
+{
+	unsigned int	hash;
+
+	hash = 5381;
+	while (len--)
+		hash = hash * 33 + (unsigned char)*key++;
+	return (hash % ENV_BUCKETS);
+}
+
+/**
+ * @brief Find a variable in the environment store
+ * @param vars Environment store of the shell
+ * @param key Variable name (not necessarily NUL-terminated)
+ * @param len Length of the name
+ * @return The variable, or NULL if it is not set
+ */
+t_var	*env_find(t_env *vars, const char *key, size_t len)
+{
+	t_var	*var;
+
+	var = vars->bucket[env_hash(key, len)];
+	while (var && (var->klen != len || ft_strncmp(var->str, key, len)))
+		var = var->next;
+	return (var);
+}
+
+/**
+ * @brief Get the value of an environment variable
+ * @param shell Shell state holding the environment store
+ * @param key Variable name
+ * @return Value of the variable (owned by the store), or NULL if the
+ *         variable is unset or exported without a value
+ *
+ * One bucket walk instead of a linear scan of the whole environment;
+ * used for PATH lookups and $VAR expansion.
+ */
+char	*env_get(t_shell *shell, const char *key)
+{
+	t_var	*var;
+
+	var = env_find(&shell->vars, key, ft_strlen(key));
+	if (!var || !var->has_value)
+		return (NULL);
+	return (var->str + var->klen + 1);
+}
+
+/**
+ * @brief Set (or export without value) an environment variable
+ * @param shell Shell state holding the environment store
+ * @param key Variable name
+ * @param value New value, or NULL to mark the name as exported only
+ *
+ * New variables keep their insertion order for env and export listings.
+ * The cached envp array is marked stale and rebuilt on the next exec.
+ */
+void	env_set(t_shell *shell, const char *key, const char *value)
+{
+	t_var	*var;
+	size_t	len;
+
+	len = ft_strlen(key);
+	var = env_find(&shell->vars, key, len);
+	if (var)
+		free(var->str);
+	else
+		var = env_new(&shell->vars, key, len);
+	if (value)
+	{
+		var->str = ft_strjoin(key, "=");
+		var->str = ft_strjoin_free(var->str, value);
+	}
+	else
+		var->str = ft_strdup(key);
+	var->has_value = (value != NULL);
+	shell->vars.dirty = true;
+	hash_env_changed(shell, key);
+}
+
+/**
+ * @brief Remove an environment variable
+ * @param shell Shell state holding the environment store
+ * @param key Variable name (unset of an unknown name is a no-op)
+ */
+void	env_unset(t_shell *shell, const char *key)
+{
+	t_var	*var;
+
+	var = env_find(&shell->vars, key, ft_strlen(key));
+	if (!var)
+		return ;
+	env_drop(&shell->vars, var);
+	shell->vars.dirty = true;
+	hash_env_changed(shell, key);
+}
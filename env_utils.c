@@ -0,0 +1,121 @@
+#include "minishell.h"
+#include "libft.h"
+
+/**
+ * @brief Allocate a variable and link it into the environment store
+ * @param vars Environment store of the shell
+ * @param key Variable name
+ * @param len Length of the name
+ * @return The new variable; the caller fills in str and has_value
+ */
+t_var	*env_new(t_env *vars, const char *key, size_t len)
+{
+	t_var	*var;
+	t_var	**bucket;
+
+	var = ft_malloc(sizeof(t_var));
+	var->klen = len;
+	bucket = &vars->bucket[env_hash(key, len)];
+	var->next = *bucket;
+	*bucket = var;
+	var->prev_ord = vars->tail;
+	var->next_ord = NULL;
+	if (vars->tail)
+		vars->tail->next_ord = var;
+	else
+		vars->head = var;
+	vars->tail = var;
+	vars->count++;
+	return (var);
+}
+
+/**
+ * @brief Unlink a variable from the environment store and free it
+ * @param vars Environment store of the shell
+ * @param var Variable to remove
+ */
+void	env_drop(t_env *vars, t_var *var)
+{
+	t_var	**link;
+
+	link = &vars->bucket[env_hash(var->str, var->klen)];
+	while (*link != var)
+		link = &(*link)->next;
+	*link = var->next;
+	if (var->prev_ord)
+		var->prev_ord->next_ord = var->next_ord;
+	else
+		vars->head = var->next_ord;
+	if (var->next_ord)
+		var->next_ord->prev_ord = var->prev_ord;
+	else
+		vars->tail = var->prev_ord;
+	vars->count--;
+	free(var->str);
+	free(var);
+}
+
+/**
+ * @brief Get the environment as a NULL-terminated envp array
+ * @param shell Shell state holding the environment store
+ * @return shell->env, rebuilt only if a variable changed since last call
+ *
+ * The array points at the "KEY=value" strings held by the store, so a
+ * rebuild only allocates the pointer array; shell->env owns nothing
+ * else and must be released with free(), not ft_free_arr().
+ * Names exported without a value are left out, as in env(1).
+ */
+char	**env_envp(t_shell *shell)
+{
+	t_var	*var;
+	int		i;
+
+	if (shell->env && !shell->vars.dirty)
+		return (shell->env);
+	free(shell->env);
+	shell->env = ft_malloc((shell->vars.count + 1) * sizeof(char *));
+	i = 0;
+	var = shell->vars.head;
+	while (var)
+	{
+		if (var->has_value)
+			shell->env[i++] = var->str;
+		var = var->next_ord;
+	}
+	shell->env[i] = NULL;
+	shell->vars.dirty = false;
+	return (shell->env);
+}
+
+/**
+ * @brief Fill the environment store from the envp given to main()
+ * @param shell Shell state holding the environment store
+ * @param envp Environment of the process ("KEY=value" strings)
+ *
+ * Startup fast path: each entry is already in the "KEY=value" form the
+ * store keeps, so it is indexed by its name length and copied with one
+ * strdup() instead of going through env_set()'s split and re-join.
+ * A later duplicate of a name replaces the earlier one.
+ */
+void	env_init(t_shell *shell, char **envp)
+{
+	char	*eq;
+	t_var	*var;
+
+	while (envp && *envp)
+	{
+		eq = ft_strchr(*envp, '=');
+		if (eq)
+		{
+			var = env_find(&shell->vars, *envp, eq - *envp);
+			if (var)
+				free(var->str);
+			else
+				var = env_new(&shell->vars, *envp, eq - *envp);
+			var->str = ft_strdup(*envp);
+			var->has_value = true;
+		}
+		envp++;
+	}
+	shell->vars.dirty = true;
+}
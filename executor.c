@@ -18,7 +18,7 @@ static bool	execute_currdir(t_cmds *cmd, t_shell *shell)
 	// Handle empty command case
 	if (cmd->str[0][0] == '\0')
 	{
-		ft_putstr_fd("minishell: : command not found\n", STDERR);
+		diag("minishell: : command not found\n");
 		exit(127);
 	}
 
@@ -30,10 +30,9 @@ static bool	execute_currdir(t_cmds *cmd, t_shell *shell)
 	if (access(cmd->str[0], F_OK) == 0)
 	{
 		// Execute the command directly with full path
-		if (execve(cmd->str[0], cmd->str, shell->env) == -1)
+		if (execve(cmd->str[0], cmd->str, env_envp(shell)) == -1)
 		{
-			ft_putstr_fd("minishell: ", STDERR);
-			perror(cmd->str[0]);
+			diag("minishell: %s: %m\n", cmd->str[0]);
 			exit(126);
 		}
 	}
@@ -46,35 +45,19 @@ static bool	execute_currdir(t_cmds *cmd, t_shell *shell)
  * @param shell Shell state for environment and configuration access
  * @return 1 if command was a built-in and executed, 0 if not a built-in
  *
- * Supported built-ins:
- * - pwd: Print working directory
- * - echo: Display text with optional -n flag
- * - cd: Change directory
- * - export: Set environment variables
- * - unset: Remove environment variables
- * - env: Display environment variables
- * - exit: Exit the shell
+ * Dispatches on cmd->builtin, the id assigned by resolve_cmds(), through
+ * the table in run_builtin() (see builtin.c for the supported built-ins).
  *
  * Uses global g_return_value to store the exit status of executed built-ins
+ * Built-in output is buffered in shell->out and flushed once here, before
+ * the caller restores stdout
  */
 int	execute_builtin(t_cmds *cmd, t_shell *shell)
 {
-	if (ft_strncmp(cmd->str[0], "pwd", 4) == 0)
-		g_return_value = ft_pwd();
-	else if (ft_strncmp(cmd->str[0], "echo", 5) == 0)
-		g_return_value = ft_echo(cmd);
-	else if (ft_strncmp(cmd->str[0], "cd", 3) == 0)
-		g_return_value = ft_cd(cmd, shell);
-	else if (ft_strncmp(cmd->str[0], "export", 7) == 0)
-		g_return_value = ft_export(cmd, shell, 0);
-	else if (ft_strncmp(cmd->str[0], "unset", 6) == 0)
-		g_return_value = ft_unset(cmd, shell);
-	else if (ft_strncmp(cmd->str[0], "env", 4) == 0)
-		g_return_value = ft_env(shell->env);
-	else if (ft_strncmp(cmd->str[0], "exit", 5) == 0)
-		g_return_value = ft_exit(cmd);
-	else
+	if (cmd->builtin == BI_NONE)
 		return (0); // Not a built-in command
+	g_return_value = run_builtin(cmd, shell);
+	out_flush(&shell->out); // One write for everything the built-in printed
 	return (1); // Successfully executed built-in
 }
 
@@ -87,70 +70,86 @@ int	execute_builtin(t_cmds *cmd, t_shell *shell)
  * 1. Check if command is empty (exit with status 0)
  * 2. Try built-in commands first
  * 3. Try current directory/absolute path execution
- * 4. Search PATH environment variable for external commands
- * 5. Fallback to execution without PATH if PATH not found
+ * 4. Execute the location found by resolve_cmds() in the parent
  *
  * This function always exits the process after execution attempt
  */
 static void	execute_cmd(t_cmds *cmd, t_shell *shell)
 {
-	int		i;
-
-	i = 0;
 	// Handle empty command
 	if (!cmd->str[0])
 		exit(0);
 
 	// Try built-in first, then current directory execution
 	if (!execute_builtin(cmd, shell) && !execute_currdir(cmd, shell))
-	{
-		// Search for PATH environment variable
-		while (shell->env && shell->env[i])
-		{
-			if (ft_strncmp(shell->env[i], "PATH=", 5) == 0)
-				break ;
-			i++;
-		}
-
-		// Execute with PATH if found, otherwise try without PATH
-		if (shell->env[i])
-			ft_execve(cmd, shell, ft_split(&shell->env[i][5], ':'));
-		ft_execve(cmd, shell, NULL);
-	}
+		ft_execve(cmd, shell, cmd->path);
 	exit(g_return_value);
 }
 
 /**
- * @brief Handle pipe setup and process creation for pipeline commands
+ * @brief Launch one command of the pipeline
  * @param cmd Current command in the pipeline
- * @param prev_fd File descriptor from previous command's output (or -1 for first)
+ * @param prev_fd Read end of the previous command's pipe (or -1 for first)
  * @param shell Shell state for environment and configuration
  *
  * Pipeline management:
- * - Sets up signal handling for pipeline execution
- * - Creates pipe if current command has a next command
- * - Forks child process for command execution
- * - In child: sets up input/output redirection via pipes
+ * - Pipes already exist (created up front by open_pipeline)
+ * - With `shopt -s lastpipe`, a built-in last stage runs in the parent
+ * - Plain `cat` stages are served by a splice() helper (see copy_stage)
+ * - External commands are started with posix_spawn() (see spawn_stage)
+ * - Built-ins fork a child process for command execution
+ * - In child: dup2()s its two pipe ends, then closes every other
+ *   descriptor (see fd_compact)
  * - Handles redirections before command execution
  * - Parent returns immediately to continue pipeline setup
  */
 static void	handle_pipes(t_cmds *cmd, int prev_fd, t_shell *shell)
-{}
+{
+	cmd->exit_status = 0;
+	if (!cmd->next && prev_fd != -1 && is_builtin(cmd) && !shell->bg
+		&& (shell->opts & OPT_LASTPIPE))
+		return (run_in_parent(cmd, prev_fd, shell));
+	if (is_copy_stage(cmd, shell))
+		return (copy_stage(cmd, prev_fd, shell));
+	if (can_spawn(cmd, shell))
+		return (spawn_stage(cmd, prev_fd, shell));
+	cmd->pid = ft_fork();
+	job_pgrp(shell, cmd->pid);
+	if (cmd->pid == 0)
+	{
+		if (prev_fd != -1)
+			dup2(prev_fd, STDIN);
+		if (cmd->next)
+			dup2(cmd->pipefd[1], STDOUT);
+		close_pipeline(shell);
+		if (!handle_redirections(cmd, shell) || !heredoc_stdin(cmd))
+			exit(1);
+		fd_compact(shell); // Only stdin/stdout/stderr survive
+		execute_cmd(cmd, shell);
+	}
+}
 
 /**
  * @brief Main execution entry point - connects entire command pipeline
  * @param shell Shell state containing parsed commands and environment
  *
  * Execution flow:
- * 1. Process all heredocs first (<<)
- * 2. Check for single command optimization
- * 3. Create pipeline by iterating through linked command list
- * 4. For each command: setup pipes, fork process, manage file descriptors
- * 5. Wait for all child processes to complete
+ * 0. A leading `time` reserved word re-enters through time_pipeline()
+ * 1. Reset the per-line arena, report finished background jobs,
+ *    collect all heredoc bodies (<<) in memory; each stage gets its
+ *    body on stdin only when it is launched (see heredoc_stdin)
+ * 2. Resolve PATH commands in the parent (shared command hash table)
+ * 3. Check for single command optimization
+ * 4. Create all pipes of the pipeline up front
+ * 5. For each command: launch it connected to its neighbours' pipes
+ * 6. Close every pipe end in the parent, then wait for all children
+ *    (or record them in the job table for a trailing `&`)
+ * 7. Write the MINISHELL_TRACE records of the line (see trace_line)
+ *    and, in debug mode, report leaked fds (see fd_report)
  *
  * Pipeline coordination:
  * - Maintains prev_fd to chain commands together
- * - Properly closes file descriptors to avoid leaks
+ * - Pipe ends are close-on-exec and closed once, after the launch loop
  * - Handles shell->stop flag for early termination
  */
 void	execute(t_shell *shell)
@@ -158,27 +157,59 @@ void	execute(t_shell *shell)
 	t_cmds	*curr;
 	int		prev_fd;
 
+	// `time pipeline`: strip the reserved word and measure the rest
+	if (time_prefix(shell))
+		return (time_pipeline(shell));
+
+	// `pipeline &`: strip the operator, the job is not waited for
+	bg_suffix(shell);
+
+	// Release the previous command line's per-line allocations
+	arena_reset(shell);
+	reap_jobs(shell, true); // Report background jobs that are done
+
 	// Process heredocs before any command execution
+	shell->stamp[TR_HEREDOCS] = trace_now(shell);
 	handle_heredocs(shell);
 
+	// Resolve PATH commands once, before any fork
+	shell->stamp[TR_RESOLVE] = trace_now(shell);
+	resolve_cmds(shell);
+
 	prev_fd = -1;
 	curr = shell->cmds; // Start with first command
 
 	// Optimization: handle single command without unnecessary forking
-	if (curr->next == NULL && single_cmd(shell))
-		return ;
+	if (curr->next == NULL && !shell->bg && single_cmd(shell))
+	{
+		trace_line(shell);
+		return (fd_report(shell));
+	}
+
+	// Background job: wait for a free slot under `shopt -s joblimit`
+	if (shell->bg)
+		job_throttle(shell);
+
+	// Create every pipe before the first stage is launched
+	open_pipeline(shell);
 
 	// Execute pipeline: iterate through all commands
 	while (curr && !shell->stop)
 	{
+		curr->stamp.fork = trace_now(shell); // Stamps are 0 unless tracing
 		handle_pipes(curr, prev_fd, shell);
-
-		// Clean up file descriptors
-		close(prev_fd); // Close previous read end
+		curr->stamp.exec = trace_now(shell);
+		curr->stamp.pid = curr->pid;
+		curr->stamp.path = trace_path(shell, curr->path);
 		prev_fd = curr->pipefd[0]; // Save current read end for next command
-		close(curr->pipefd[1]); // Close current write end
-
 		curr = curr->next; // Move to next command
 	}
-	ft_waitpid(shell); 	// Wait for all child processes to complete
+	close_pipeline(shell); // Parent no longer needs any pipe end
+	place_pipeline(shell); // Pin stages under MINISHELL_AFFINITY
+	if (shell->bg)
+		job_add(shell); // Background: remember the job and return
+	else
+		ft_waitpid(shell); 	// Wait for all child processes to complete
+	trace_line(shell); // One MINISHELL_TRACE record per command
+	fd_report(shell); // Debug: list fds left open (MINISHELL_FDCHECK)
 }
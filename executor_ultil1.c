@@ -4,60 +4,41 @@
 
 /**
  * @brief Check if a command is a shell built-in
- * @param cmd Command structure containing the command name to check
+ * @param cmd Command structure tagged by resolve_cmds()
  * @return true if the command is a built-in, false otherwise
  *
- * Supported built-in commands:
- * - pwd: Print working directory
- * - echo: Display text with optional flags
- * - cd: Change directory
- * - export: Set environment variables
- * - unset: Remove environment variables
- * - env: Display environment variables
- * - exit: Exit the shell
+ * Only reads the id stored in cmd->builtin; the name itself is matched
+ * once by builtin_id() (see builtin.c for the supported built-ins).
  *
  * Used for command routing to determine execution method
  */
 
 bool	is_builtin(t_cmds *cmd)
 {
-	if (ft_strncmp(cmd->str[0], "pwd", 4) == 0)
-		return (true);
-	else if (ft_strncmp(cmd->str[0], "echo", 5) == 0)
-		return (true);
-	else if (ft_strncmp(cmd->str[0], "cd", 3) == 0)
-		return (true);
-	else if (ft_strncmp(cmd->str[0], "export", 7) == 0)
-		return (true);
-	else if (ft_strncmp(cmd->str[0], "unset", 6) == 0)
-		return (true);
-	else if (ft_strncmp(cmd->str[0], "env", 4) == 0)
-		return (true);
-	else if (ft_strncmp(cmd->str[0], "exit", 5) == 0)
-		return (true);
-	return (false);
+	return (cmd->builtin != BI_NONE);
 }
 
 /**
  * @brief Wrapper for dup() system call with error handling
  * @param fd File descriptor to duplicate
- * @return New file descriptor pointing to the same file
+ * @return New close-on-exec file descriptor pointing to the same file
  *
  * Creates a duplicate of the given file descriptor.
  * Used primarily for saving stdin/stdout before redirections
- * so they can be restored later.
+ * so they can be restored later. The copy is close-on-exec
+ * (F_DUPFD_CLOEXEC), so no child ever inherits a saved descriptor.
  *
- * Exits the program on failure with perror message.
+ * Exits the program on failure, after reporting errno through diag().
  */
 
 int	ft_dup(int fd)
 {
 	int	new_fd;
 
-	new_fd = dup(fd);
+	new_fd = fcntl(fd, F_DUPFD_CLOEXEC, 0);
 	if (new_fd == -1)
 	{
-		perror("dup");
+		diag("dup: %m\n");
 		exit(-1);
 	}
 	return (new_fd);
@@ -77,7 +58,7 @@ int	ft_dup(int fd)
  * - ft_dup2(pipe[0], STDIN) - redirect stdin from pipe read end
  * - ft_dup2(file_fd, STDOUT) - redirect stdout to file
  *
- * Exits the program on failure with perror message.
+ * Exits the program on failure, after reporting errno through diag().
  */
 
 
@@ -85,7 +66,7 @@ void	ft_dup2(int fd1, int fd2)
 {
 	if (dup2(fd1, fd2) == -1)
 	{
-		perror("dup2");
+		diag("dup2: %m\n");
 		exit(-1);
 	}
 	close(fd1);
@@ -103,7 +84,7 @@ void	ft_dup2(int fd1, int fd2)
  * - Positive: Code is running in parent, value is child's PID
  * - Negative: fork() failed (handled by exit)
  *
- * Exits the program on failure with perror message.
+ * Exits the program on failure, after reporting errno through diag().
  */
 
 pid_t	ft_fork(void)
@@ -113,32 +94,43 @@ pid_t	ft_fork(void)
 	pid = fork();
 	if (pid == -1)
 	{
-		perror("fork");
+		diag("fork: %m\n");
 		exit(-1);
 	}
 	return (pid);
 }
 
 /**
- * @brief Wrapper for pipe() system call with error handling
+ * @brief Wrapper for pipe2() system call with error handling
  * @param fd Array of 2 integers to store pipe file descriptors
+ * @param size Pipe buffer size in bytes, or 0 for the kernel default
  *
  * Creates a pipe for inter-process communication.
  * fd[0] becomes the read end, fd[1] becomes the write end.
+ * Both ends are close-on-exec: dup2() onto stdin/stdout clears the
+ * flag on the copy, so exec'd children keep only the ends they use.
  *
  * Usage in pipelines:
- * - Parent creates pipe before forking
+ * - Parent creates all pipes before forking (open_pipeline)
  * - Child processes connect stdin/stdout to appropriate pipe ends
  * - Data flows from one command's stdout to next command's stdin
  *
- * Exits the program on failure with perror message.
+ * A larger buffer (F_SETPIPE_SZ) lets bulk producers and consumers
+ * run longer between context switches. The kernel rounds the size up
+ * to a power of two of pages; if it refuses (above
+ * /proc/sys/fs/pipe-max-size for unprivileged users) the default
+ * buffer is kept.
+ *
+ * Exits the program on failure, after reporting errno through diag().
  */
 
-void	ft_pipe(int fd[2])
+void	ft_pipe(int fd[2], int size)
 {
-	if (pipe(fd) == -1)
+	if (pipe2(fd, O_CLOEXEC) == -1)
 	{
-		perror("pipe");
+		diag("pipe: %m\n");
 		exit(-1);
 	}
+	if (size > 0)
+		fcntl(fd[1], F_SETPIPE_SZ, size);
 }
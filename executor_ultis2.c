@@ -1,22 +1,46 @@
 #include "minishell.h"
 #include "libft.h"
+#include <errno.h>
 
 /**
- * @brief Execute external command by searching through PATH directories
- * @param cmd Command structure containing command name and arguments
- * @param shell Shell state for environment access
- * @param path Array of PATH directories to search (can be NULL)
+ * @brief Resolve a command name to its location in PATH
+ * @param shell Shell state for environment and command hash table
+ * @param name Command name without any '/'
+ * @return Resolved path owned by the hash table, or NULL if not found
  *
- * Execution process:
- * 1. If path is provided, search each directory for the command
- * 2. Construct full path by joining directory + "/" + command_name
- * 3. Check if constructed path exists and is accessible
- * 4. Attempt execution with execve()
- * 5. If command not found in any PATH directory, exit with 127
+ * Resolution process:
+ * 1. Return the remembered location if the hash table knows the name
+ * 2. Otherwise look name up in each PATH directory through its
+ *    pre-opened fd (see path_has())
+ * 3. Join directory + "/" + name once for the first hit and remember
+ *    it in the hash table
  *
- * Memory management:
- * - Frees path array before exit
- * - Frees temporary path strings during search
+ * The returned string belongs to the hash table and must not be freed.
+ */
+char	*find_in_path(t_shell *shell, char *name)
+{
+	char	**path;
+	char	*tmp;
+	int		i;
+
+	tmp = hash_lookup(shell, name);
+	if (tmp)
+		return (tmp);
+	path = path_dirs(shell);
+	i = 0;
+	while (path && path[i] && !path_has(shell, i, name))
+		i++;
+	if (!path || !path[i])
+		return (NULL);
+	tmp = arena_path(&shell->arena, path[i], name);
+	return (hash_insert(shell, name, ft_strdup(tmp)));
+}
+
+/**
+ * @brief Execute external command found through PATH resolution
+ * @param cmd Command structure containing command name and arguments
+ * @param shell Shell state for environment access
+ * @param path Resolved command location from resolve_cmds() (can be NULL)
  *
  * Exit codes:
  * - 127: Command not found
@@ -25,30 +49,14 @@
  * This function always exits the process - never returns to caller.
  */
 
-void	ft_execve(t_cmds *cmd, t_shell *shell, char **path)
+void	ft_execve(t_cmds *cmd, t_shell *shell, char *path)
 {
-	int		i;
-	char	*tmp;
-
-	i = 0;
-	while (path && path[i])
+	if (path && execve(path, cmd->str, env_envp(shell)) == -1)
 	{
-		tmp = ft_strjoin(path[i], "/");
-		tmp = ft_strjoin_free(tmp, cmd->str[0]);
-		if (access(tmp, F_OK) == 0
-			&& execve(tmp, cmd->str, shell->env) == -1)
-		{
-			ft_free_arr(path);
-			perror(cmd->str[0]);
-			exit(-1);
-		}
-		free(tmp);
-		i++;
+		diag("%s: %m\n", cmd->str[0]);
+		exit(-1);
 	}
-	ft_free_arr(path);
-	ft_putstr_fd("minishell: ", STDERR);
-	ft_putstr_fd(cmd->str[0], STDERR);
-	ft_putstr_fd(": command not found\n", STDERR);
+	cmd_not_found(cmd);
 	exit(127);
 }
 
@@ -57,19 +65,21 @@ void	ft_execve(t_cmds *cmd, t_shell *shell, char **path)
  * @param shell Shell state containing command list with process IDs
  *
  * Process management:
- * - Iterates through all commands in the pipeline
- * - Waits for each child process to complete
- * - Analyzes exit status to determine how process terminated
- * - Sets global return value based on exit status or signal
+ * - Reaps children with wait4(-1) in the order they finish, so a stage
+ *   that exits early never lingers as a zombie behind a slow one
+ * - Keeps each stage's exit status and resource usage (reported by
+ *   `time -s`) on its t_cmds, see reap_child()
+ * - Stages that were never started (pid -1) keep cmd->exit_status
+ * - Background children finishing meanwhile are recorded in their job
  *
  * Exit status handling:
- * - Normal exit: Uses WEXITSTATUS() to get exit code
- * - Signal termination: Maps signals to conventional exit codes
- *   - SIGINT (Ctrl-C): 130
- *   - SIGQUIT (Ctrl-\): 131
+ * - The pipeline returns the status of its last stage
+ * - Normal exit: exit code; signal termination: 128 + signal number
+ *   (130 for SIGINT, 131 for SIGQUIT)
  *
  * Signal propagation:
- * - If any process exits with 130 or 131, sets shell->stop = true
+ * - A child dying with 130 or 131 sets shell->stop = true as soon as it
+ *   is reaped (reap_child()); stages run in the shell are checked below
  * - This prevents further command execution in interactive mode
  *
  * Uses global g_return_value to store the final exit status
@@ -77,24 +87,29 @@ void	ft_execve(t_cmds *cmd, t_shell *shell, char **path)
 
 void	ft_waitpid(t_shell *shell)
 {
-	t_cmds	*curr;
-	int		status;
-	int		sig;
+	t_cmds			*curr;
+	struct rusage	ru;
+	pid_t			pid;
+	int				status;
+	int				left;
 
+	left = running_stages(shell);
+	while (left > 0)
+	{
+		pid = wait4(-1, &status, 0, &ru);
+		if (pid == -1 && errno == EINTR)
+			continue ;
+		if (pid == -1)
+			break ;
+		if (reap_child(shell, pid, status, &ru))
+			left--;
+		else
+			job_child(shell, pid, status);
+	}
 	curr = shell->cmds;
 	while (curr)
 	{
-		waitpid(curr->pid, &status, 0);
-		if (WIFEXITED(status))
-			g_return_value = WEXITSTATUS(status);
-		else if (WIFSIGNALED(status))
-		{
-			sig = WTERMSIG(status);
-			if (sig == SIGINT)
-				g_return_value = 130;
-			else if (sig == SIGQUIT)
-				g_return_value = 131;
-		}
+		g_return_value = curr->exit_status;
 		if (g_return_value == 130 || g_return_value == 131)
 			shell->stop = true;
 		curr = curr->next;
@@ -103,36 +118,21 @@ void	ft_waitpid(t_shell *shell)
 /**
  * @brief Handle single built-in command execution without forking
  * @param shell Shell state containing the single command to execute
- * @return true if command was a built-in and executed, false otherwise
+ * @return true if command was handled in the parent, false otherwise
  *
  * Optimization for single built-in commands:
  * - Avoids unnecessary forking for built-ins when no pipeline exists
- * - Preserves original stdin/stdout for restoration after redirections
- * - Handles redirections properly for built-in commands
- *
- * Process:
- * 1. Check if the only command is a built-in
- * 2. Save current stdin/stdout file descriptors
- * 3. Apply any redirections (>, <, >>, <<)
- * 4. Execute the built-in command
- * 5. Restore original stdin/stdout
- *
+ * - Reports unknown commands (failed PATH resolution) without a fork
+ * - Stdin/stdout save, redirections and restore happen in run_in_parent()
 */
 
 bool	single_cmd(t_shell *shell)
 {
-	int		save_stdin;
-	int		save_stdout;
-
-	if (is_builtin(shell->cmds))
-	{
-		save_stdin = ft_dup(STDIN);
-		save_stdout = ft_dup(STDOUT);
-		if (handle_redirections(shell->cmds, shell))
-			execute_builtin(shell->cmds, shell);
-		ft_dup2(save_stdin, STDIN);
-		ft_dup2(save_stdout, STDOUT);
-		return (true);
-	}
-	return (false);
+	if (!is_builtin(shell->cmds) && !is_unresolved(shell->cmds))
+		return (false);
+	shell->cmds->stamp.fork = trace_now(shell);
+	run_in_parent(shell->cmds, -1, shell);
+	shell->cmds->stamp.exec = trace_now(shell);
+	shell->cmds->stamp.pid = -1;
+	return (true);
 }
@@ -0,0 +1,102 @@
+#include "minishell.h"
+#include "libft.h"
+#include <dirent.h>
+
+/**
+ * @brief Check whether an fd is one the shell keeps open on purpose
+ * @param shell Shell state holding the long-lived descriptors
+ * @param fd Descriptor to check
+ * @return true for the trace log and the PATH directory fds
+ */
+static bool	fd_owned(t_shell *shell, int fd)
+{
+	int	i;
+
+	if (fd == shell->trace_fd)
+		return (true);
+	i = 0;
+	while (shell->path && shell->path[i])
+		if (shell->path_fd[i++] == fd)
+			return (true);
+	return (false);
+}
+
+/**
+ * @brief Print one leaked descriptor with what it points to
+ * @param fd Leaked descriptor
+ *
+ * Example: "minishell: fd 5 open after execute: pipe:[1234] (inherited
+ * by children)". Descriptors without FD_CLOEXEC are the harmful ones:
+ * every later child keeps them, and pipe readers miss their EOF.
+ */
+static void	fd_leak(int fd)
+{
+	char	link[64];
+	char	target[256];
+	char	*num;
+	ssize_t	len;
+
+	num = ft_itoa(fd);
+	ft_memcpy(link, "/proc/self/fd/", 15);
+	ft_memcpy(link + 14, num, ft_strlen(num) + 1);
+	len = readlink(link, target, sizeof(target) - 1);
+	if (len < 0)
+		len = 0;
+	target[len] = '\0';
+	if (fcntl(fd, F_GETFD) & FD_CLOEXEC)
+		diag("minishell: fd %d open after execute: %s\n", fd, target);
+	else
+		diag("minishell: fd %d open after execute: %s (inherited by "
+			"children)\n", fd, target);
+	free(num);
+}
+
+/**
+ * @brief Shrink a forked child's fd table to stdin/stdout/stderr
+ * @param shell Shell state of the child (its copies of shell fds)
+ *
+ * Close-on-exec only helps children that exec. Forked built-ins and
+ * the cat helper never do, and would keep running with every shell
+ * descriptor: the PATH directory fds, the trace log and whatever else
+ * was open. Called once their stdio is wired, so they run with the
+ * three descriptors they use. The PATH cache is dropped first, so a
+ * built-in that searches PATH reopens it.
+ */
+void	fd_compact(t_shell *shell)
+{
+	path_drop(shell);
+	shell->trace_fd = -1;
+	close_range(STDERR + 1, ~0U, 0);
+}
+
+/**
+ * @brief Debug report of descriptors left open by a command line
+ * @param shell Shell state (shell->fd_check set from MINISHELL_FDCHECK)
+ *
+ * Called at the end of execute(). Once a line has run, the shell
+ * should only hold stdin/stdout/stderr plus the descriptors it owns
+ * (see fd_owned); anything else is a leak from a pipe, a heredoc or a
+ * saved stdio copy, and is listed on stderr.
+ */
+void	fd_report(t_shell *shell)
+{
+	DIR				*dir;
+	struct dirent	*ent;
+	int				fd;
+
+	if (!shell->fd_check)
+		return ;
+	dir = opendir("/proc/self/fd");
+	if (!dir)
+		return ;
+	ent = readdir(dir);
+	while (ent)
+	{
+		fd = ft_atoi(ent->d_name);
+		if (ft_isdigit(ent->d_name[0]) && fd > STDERR && fd != dirfd(dir)
+			&& !fd_owned(shell, fd))
+			fd_leak(fd);
+		ent = readdir(dir);
+	}
+	closedir(dir);
+}
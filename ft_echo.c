@@ -9,12 +9,13 @@
  *
  * Continues parsing consecutive -n flags (like -n, -nn, -nnn) until it finds
  * an invalid flag or reaches the end of -n flags. This handles bash behavior
- * where multiple -n flags can be chained together.
+ * where multiple -n flags can be chained together. Stops at the NULL
+ * terminator, so `echo -n` with no words after the flags is safe.
  */
 static int	last_check(int i, t_cmds *cmd)
 {
 	int	j;
-	while ((ft_strncmp(cmd->str[i], "-n", 2) == 0))
+	while (cmd->str[i] && ft_strncmp(cmd->str[i], "-n", 2) == 0)
 	{
 		j = 1;
 		while (cmd->str[i][j] == 'n')
@@ -37,11 +38,12 @@ static int	last_check(int i, t_cmds *cmd)
  *
  * Examines the first argument to determine if it's a valid -n flag.
  * If valid, sets the newline suppression flag and advances to check
- * for additional consecutive -n flags via last_check().
+ * for additional consecutive -n flags via last_check(). A bare `echo`
+ * has no first argument (cmd->str[1] is NULL) and prints a newline.
  */
 static int	check_n(t_cmds *cmd, int i, int *check, int *n)
 {
-	if ((ft_strncmp(cmd->str[i], "-n", 2) == 0) && i == 1)
+	if (cmd->str[i] && ft_strncmp(cmd->str[i], "-n", 2) == 0 && i == 1)
 	{
 		while (cmd->str[i][*check] && cmd->str[i][*check] == 'n')
 			*check += 1;
@@ -62,13 +64,15 @@ static int	check_n(t_cmds *cmd, int i, int *check, int *n)
 /**
  * @brief Implementation of echo builtin command
  * @param cmd Command structure containing arguments and metadata
+ * @param shell Shell state owning the built-in output buffer
  * @return Always returns 0 (echo command always succeeds)
  *
  * Mimics bash echo behavior:
  * - Prints all arguments separated by spaces
  * - Supports -n flag to suppress trailing newline
  * - Handles multiple consecutive -n flags (bash behavior)
- * - Writes output to stdout (file descriptor 1)
+ * - Writes output to stdout through the built-in output buffer,
+ *   so the whole line leaves in one write() instead of one per word
  *
  * Examples:
  *   echo hello world        -> "hello world\n"
@@ -76,7 +80,7 @@ static int	check_n(t_cmds *cmd, int i, int *check, int *n)
  *   echo -nn hello world    -> "hello world"
  *   echo -n -n hello world  -> "hello world"
  */
-int	ft_echo(t_cmds *cmd)
+int	ft_echo(t_cmds *cmd, t_shell *shell)
 {
 	int	i;
 	int	n;
@@ -87,12 +91,12 @@ int	ft_echo(t_cmds *cmd)
 	i = check_n(cmd, i, &check, &n);
 	while (cmd->str[i])
 	{
-		ft_putstr_fd(cmd->str[i], 1);
+		out_puts(&shell->out, cmd->str[i]);
 		if (cmd->str[i + 1] != 0)
-			ft_putchar_fd(' ', 1);
+			out_putc(&shell->out, ' ');
 		i++;
 	}
 	if (n && check)
-		ft_putchar_fd('\n', 1);
+		out_putc(&shell->out, '\n');
 	return (0);
 }
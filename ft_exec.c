@@ -0,0 +1,156 @@
+#include "minishell.h"
+#include "libft.h"
+#include <errno.h>
+#include <signal.h>
+
+/**
+ * @brief Replace the shell process with a program
+ * @param shell Shell state for environment access
+ * @param path Location of the program
+ * @param argv Argument vector of the program (argv[0] is its name)
+ * @return Only on failure: 127 if the file does not exist, 126 otherwise
+ *
+ * Pending built-in output is flushed and SIGINT/SIGQUIT get their
+ * default action back first. Every internal fd is close-on-exec, so
+ * the program only inherits stdin/stdout/stderr and whatever the
+ * redirections put there. If execve() fails the shell keeps running
+ * (`exec` built-in), so the previous signal actions are put back.
+ */
+static int	exec_replace(t_shell *shell, char *path, char **argv)
+{
+	struct sigaction	dfl;
+	struct sigaction	old[2];
+	int					status;
+
+	out_flush(&shell->out);
+	ft_bzero(&dfl, sizeof(dfl));
+	dfl.sa_handler = SIG_DFL;
+	sigaction(SIGINT, &dfl, &old[0]);
+	sigaction(SIGQUIT, &dfl, &old[1]);
+	execve(path, argv, env_envp(shell));
+	status = 126;
+	if (errno == ENOENT)
+		status = 127;
+	diag("minishell: %s: %m\n", argv[0]);
+	sigaction(SIGINT, &old[0], NULL);
+	sigaction(SIGQUIT, &old[1], NULL);
+	return (status);
+}
+
+/**
+ * @brief Implementation of exec builtin command
+ * @param cmd Command structure containing arguments
+ * @param shell Shell state for environment and command hash table
+ * @return Only on failure: 127 for an unknown command, 126 if it could
+ *         not be executed; 0 without a command
+ *
+ * Usage: exec command [args ...]
+ *
+ * Runs in the shell process (single_cmd), after its redirections were
+ * applied, so `exec prog < in > out` starts prog with those files and
+ * no fork, no wait and no shell left behind. Without a command nothing
+ * happens: redirections on a bare `exec` are not kept for the shell.
+ */
+int	ft_exec(t_cmds *cmd, t_shell *shell)
+{
+	char	*path;
+
+	if (!cmd->str[1])
+		return (0);
+	path = cmd->str[1];
+	if (!ft_strchr(path, '/'))
+		path = find_in_path(shell, path);
+	if (!path)
+	{
+		diag("minishell: exec: %s: not found\n", cmd->str[1]);
+		return (127);
+	}
+	return (exec_replace(shell, path, cmd->str + 1));
+}
+
+/**
+ * @brief Check whether a command line can end in an implicit exec
+ * @param shell Shell state containing the parsed command list
+ * @return true for a single external command, not timed, not in the
+ *         background, whose location is known, with no job left
+ *
+ * Does execute()'s per-line preamble itself: the arena is reset and
+ * finished jobs are reported. A job still running would become a
+ * child of the exec'd program (whose wait() could collect it) and
+ * never be reported, so the line then goes through execute().
+ */
+static bool	tail_candidate(t_shell *shell)
+{
+	t_cmds	*cmd;
+	int		i;
+
+	cmd = shell->cmds;
+	if (cmd->next || !cmd->str[0] || ft_strncmp(cmd->str[0], "time", 5) == 0)
+		return (false);
+	i = 0;
+	while (cmd->str[i + 1])
+		i++;
+	if (ft_strncmp(cmd->str[i], "&", 2) == 0)
+		return (false);
+	arena_reset(shell);
+	reap_jobs(shell, true);
+	if (shell->jobs)
+		return (false);
+	shell->stamp[TR_HEREDOCS] = trace_now(shell);
+	shell->stamp[TR_RESOLVE] = shell->stamp[TR_HEREDOCS];
+	resolve_cmds(shell);
+	return (!is_builtin(cmd) && !is_unresolved(cmd)
+		&& (cmd->path || ft_strchr(cmd->str[0], '/')));
+}
+
+/**
+ * @brief Write the MINISHELL_TRACE record of a command about to be exec'd
+ * @param shell Shell state holding the trace fd
+ * @param cmd The command replacing the shell
+ *
+ * Nothing runs after execve() to write it, so the record is written
+ * first, like a background stage's: pid is the shell's own (the
+ * program keeps it), reap=0 and status=-1.
+ */
+static void	tail_trace(t_shell *shell, t_cmds *cmd)
+{
+	cmd->stamp.fork = trace_now(shell);
+	cmd->stamp.exec = cmd->stamp.fork;
+	cmd->pid = getpid();
+	cmd->stamp.pid = cmd->pid;
+	cmd->stamp.path = trace_path(shell, cmd->path);
+	trace_line(shell);
+	cmd->pid = -1;
+}
+
+/**
+ * @brief Run the last command of a batch script in place of the shell
+ * @param shell Shell state containing the parsed command list
+ * @return false if the line has to go through execute(); otherwise
+ *         this function does not return
+ *
+ * The script has nothing left to do once its last command finishes,
+ * so a lone external command replaces the shell instead of being
+ * spawned and waited for: one process less per invocation, and the
+ * command's exit status (or signal) is seen by the caller directly.
+ * Heredocs and redirections are set up as in a forked stage first.
+ * Heredoc collection and resolution share one trace stamp: here PATH
+ * is resolved first, to decide whether the line qualifies.
+ */
+bool	tail_exec(t_shell *shell)
+{
+	t_cmds	*cmd;
+	char	*path;
+
+	if (!tail_candidate(shell))
+		return (false);
+	cmd = shell->cmds;
+	handle_heredocs(shell);
+	if (!handle_redirections(cmd, shell) || !heredoc_stdin(cmd))
+		exit(1);
+	path = cmd->path;
+	if (!path)
+		path = cmd->str[0];
+	tail_trace(shell, cmd);
+	exit(exec_replace(shell, path, cmd->str));
+}
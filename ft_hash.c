@@ -0,0 +1,76 @@
+#include "minishell.h"
+#include "libft.h"
+
+/**
+ * @brief Print the command hash table in bash format
+ * @param shell Shell state owning the command hash table
+ *
+ * Output looks like:
+ *   hits	command
+ *      3	/usr/bin/ls
+ */
+static void	print_hash(t_shell *shell)
+{
+	t_hash	*entry;
+	int		i;
+	bool	empty;
+
+	i = 0;
+	empty = true;
+	while (i < HASH_SIZE)
+	{
+		entry = shell->hash[i++];
+		while (entry)
+		{
+			if (empty)
+				out_puts(&shell->out, "hits\tcommand\n");
+			empty = false;
+			out_putnbr(&shell->out, entry->hits, 4);
+			out_putc(&shell->out, '\t');
+			out_puts(&shell->out, entry->path);
+			out_putc(&shell->out, '\n');
+			entry = entry->next;
+		}
+	}
+	if (empty)
+		out_puts(&shell->out, "hash: hash table empty\n");
+}
+
+/**
+ * @brief Implementation of hash built-in command
+ * @param cmd Command structure containing arguments
+ * @param shell Shell state owning the command hash table
+ * @return 0 on success, 1 if a name could not be found in PATH
+ *
+ * Usage:
+ *   hash            -> list remembered commands with their hit counts
+ *   hash -r         -> forget all remembered locations
+ *   hash name ...   -> search PATH for each name and remember it
+ *
+ * Names containing '/' are never hashed and are silently ignored.
+ */
+int	ft_hash(t_cmds *cmd, t_shell *shell)
+{
+	int	i;
+	int	ret;
+
+	i = 1;
+	ret = 0;
+	if (cmd->str[1] && ft_strncmp(cmd->str[1], "-r", 3) == 0)
+	{
+		hash_clear(shell);
+		i++;
+	}
+	else if (!cmd->str[1])
+		print_hash(shell);
+	while (cmd->str[i])
+	{
+		if (!ft_strchr(cmd->str[i], '/') && !find_in_path(shell, cmd->str[i]))
+		{
+			diag("minishell: hash: %s: not found\n", cmd->str[i]);
+			ret = 1;
+		}
+		i++;
+	}
+	return (ret);
+}
@@ -0,0 +1,148 @@
+#include "minishell.h"
+#include "libft.h"
+
+/**
+ * @brief Print one job in bash `jobs` format
+ * @param shell Shell state owning the built-in output buffer
+ * @param job Job to print
+ *
+ * Output looks like:
+ *   [1]  Running		sleep 10 &
+ *   [2]  Exit 3		false &
+ */
+void	job_print(t_shell *shell, t_job *job)
+{
+	out_putc(&shell->out, '[');
+	out_putnbr(&shell->out, job->id, 0);
+	out_puts(&shell->out, "]  ");
+	if (job->left > 0)
+		out_puts(&shell->out, "Running");
+	else if (job->status == 0)
+		out_puts(&shell->out, "Done");
+	else
+	{
+		out_puts(&shell->out, "Exit ");
+		out_putnbr(&shell->out, job->status, 0);
+	}
+	out_puts(&shell->out, "\t\t");
+	out_puts(&shell->out, job->name);
+	out_puts(&shell->out, " &\n");
+}
+
+/**
+ * @brief Implementation of jobs built-in command
+ * @param cmd Command structure (jobs takes no arguments)
+ * @param shell Shell state holding the job table
+ * @return Always 0
+ *
+ * Lists every job; jobs reported as done are forgotten afterwards.
+ */
+int	ft_jobs(t_cmds *cmd, t_shell *shell)
+{
+	t_job	*job;
+	t_job	*next;
+
+	(void)cmd;
+	reap_jobs(shell, false);
+	job = shell->jobs;
+	while (job)
+	{
+		next = job->next;
+		job_print(shell, job);
+		if (job->left == 0)
+			job_remove(shell, job);
+		job = next;
+	}
+	return (0);
+}
+
+/**
+ * @brief Print "minishell: <builtin>: <spec>: no such job"
+ * @param builtin Name of the built-in reporting the error
+ * @param spec Job operand that did not match
+ */
+static void	no_such_job(const char *builtin, const char *spec)
+{
+	diag("minishell: %s: %s: no such job\n", builtin, spec);
+}
+
+/**
+ * @brief Implementation of wait built-in command
+ * @param cmd Command structure containing optional job operands
+ * @param shell Shell state holding the job table
+ * @return Status of the last job waited for (0 without operands),
+ *         127 if an operand matches no job
+ *
+ * Usage:
+ *   wait              -> wait for every background job
+ *   wait %n|pid ...   -> wait for the given jobs
+ */
+int	ft_wait(t_cmds *cmd, t_shell *shell)
+{
+	t_job	*job;
+	int		ret;
+	int		i;
+
+	ret = 0;
+	while (!cmd->str[1] && shell->jobs)
+	{
+		job_wait(shell, shell->jobs);
+		job_remove(shell, shell->jobs);
+	}
+	i = 1;
+	while (cmd->str[i])
+	{
+		job = job_find(shell, cmd->str[i]);
+		if (!job)
+		{
+			no_such_job("wait", cmd->str[i]);
+			ret = 127;
+		}
+		else
+		{
+			ret = job_wait(shell, job);
+			job_remove(shell, job);
+		}
+		i++;
+	}
+	return (ret);
+}
+
+/**
+ * @brief Implementation of fg built-in command
+ * @param cmd Command structure containing an optional job operand
+ * @param shell Shell state holding the job table
+ * @return Exit status of the job, 1 if there is no such job
+ *
+ * Prints the job's command line, hands the terminal to the job's
+ * process group while waiting for it, then takes it back.
+ */
+int	ft_fg(t_cmds *cmd, t_shell *shell)
+{
+	t_job	*job;
+	bool	tty;
+	int		ret;
+
+	job = job_find(shell, cmd->str[1]);
+	if (!job)
+	{
+		if (cmd->str[1])
+			no_such_job("fg", cmd->str[1]);
+		else
+			no_such_job("fg", "current");
+		return (1);
+	}
+	out_puts(&shell->out, job->name);
+	out_putc(&shell->out, '\n');
+	out_flush(&shell->out);
+	tty = isatty(STDIN) && job->pgid > 0;
+	if (tty)
+		signal(SIGTTOU, SIG_IGN);
+	if (tty)
+		tcsetpgrp(STDIN, job->pgid);
+	ret = job_wait(shell, job);
+	if (tty)
+		tcsetpgrp(STDIN, getpgrp());
+	job_remove(shell, job);
+	return (ret);
+}
@@ -1,5 +1,6 @@
 #include "minishell.h"
 #include "libft.h"
+#include <sys/stat.h>
 
 /**
  * @brief Get current working directory using system call wrapper
@@ -21,25 +22,136 @@ char	*ft_getcwd(void)
 	return (NULL);
 }
 
+/**
+ * @brief Lexically canonicalize an absolute path in place
+ * @param path Absolute path, rewritten without ".", ".." and "//"
+ *
+ * This is cd's logical view of the directory tree: ".." removes the
+ * previous component instead of following symlinks back up.
+ */
+static void	normalize(char *path)
+{
+	char	*r;
+	char	*w;
+	size_t	len;
+
+	r = path;
+	w = path;
+	while (*r)
+	{
+		while (*r == '/')
+			r++;
+		len = 0;
+		while (r[len] && r[len] != '/')
+			len++;
+		if (len == 2 && r[0] == '.' && r[1] == '.')
+		{
+			while (w > path && w[-1] != '/')
+				w--;
+			if (w > path)
+				w--;
+		}
+		else if (len && !(len == 1 && r[0] == '.'))
+		{
+			*w++ = '/';
+			ft_memmove(w, r, len);
+			w += len;
+		}
+		r += len;
+	}
+	if (w == path)
+		*w++ = '/';
+	*w = '\0';
+}
+
+/**
+ * @brief Get the logical working directory of the shell
+ * @param shell Shell state caching the working directory
+ * @return Cached directory (owned by the shell), or NULL if unknown
+ *
+ * Serves pwd and prompt rendering without a getcwd() path walk. Only a
+ * single stat(".") checks that the directory still exists; getcwd() is
+ * used when nothing is cached yet or the directory has been removed.
+ * If getcwd() fails too (the directory is gone), the cached logical
+ * path is kept and returned, as bash keeps printing $PWD.
+ */
+char	*shell_pwd(t_shell *shell)
+{
+	struct stat	st;
+	char		*cwd;
+
+	if (shell->pwd && stat(".", &st) == 0 && st.st_nlink > 0)
+		return (shell->pwd);
+	cwd = ft_getcwd();
+	if (cwd)
+	{
+		free(shell->pwd);
+		shell->pwd = cwd;
+	}
+	return (shell->pwd);
+}
+
+/**
+ * @brief Record a successful directory change in the shell
+ * @param shell Shell state caching the working directory
+ * @param dir Directory operand given to cd (after chdir() succeeded)
+ *
+ * Must be called by cd after every successful chdir(). Computes the new
+ * logical directory from the cached one, then keeps PWD and OLDPWD in
+ * the environment in sync so $PWD never needs a getcwd() either.
+ */
+void	pwd_update(t_shell *shell, const char *dir)
+{
+	char	*path;
+
+	if (dir[0] == '/')
+		path = ft_strdup(dir);
+	else if (shell->pwd)
+	{
+		path = ft_strjoin(shell->pwd, "/");
+		path = ft_strjoin_free(path, dir);
+	}
+	else
+		path = ft_getcwd();
+	if (!path)
+		return ;
+	normalize(path);
+	if (shell->pwd)
+		env_set(shell, "OLDPWD", shell->pwd);
+	free(shell->pwd);
+	shell->pwd = path;
+	env_set(shell, "PWD", path);
+}
+
 /**
  * @brief Implementation of pwd built-in command
- * @details Prints current working directory to stdout followed by newline.
- *          Mimics bash pwd behavior with no options support as per requirements.
- *          Handles error cases by returning appropriate exit status.
+ * @param cmd Command structure containing the optional -P flag
+ * @param shell Shell state caching the working directory
+ * @details Prints the logical working directory cached by cd.
+ *          With -P, prints the physical directory from getcwd() instead.
+ *          When no directory is known, reports the getcwd() error.
  * @return 0 on success, 1 on failure (bash-compatible exit codes)
  * @note Part of mandatory built-in commands as specified in PRD
- * @note No options parsing required - pwd accepts no flags per specification
+ * @note The -P buffer comes from the per-line arena, not the heap
  */
-int	ft_pwd(void)
+int	ft_pwd(t_cmds *cmd, t_shell *shell)
 {
 	char	*pwd;
 
-	pwd = ft_getcwd();
+	if (cmd->str[1] && ft_strncmp(cmd->str[1], "-P", 3) == 0)
+	{
+		pwd = arena_alloc(&shell->arena, PATH_MAX);
+		if (!getcwd(pwd, PATH_MAX))
+			pwd = NULL;
+	}
+	else
+		pwd = shell_pwd(shell);
 	if (pwd)
 	{
-		printf("%s\n", pwd);
-		free(pwd);
+		out_puts(&shell->out, pwd);
+		out_putc(&shell->out, '\n');
 		return (0);
 	}
+	diag("minishell: pwd: error retrieving current directory: getcwd: %m\n");
 	return (1);
 }
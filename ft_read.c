@@ -0,0 +1,201 @@
+#include "minishell.h"
+#include "libft.h"
+
+/**
+ * @brief Parse the options of read
+ * @param cmd Command structure containing argument array
+ * @param opt Receives the -r, -d and -n settings
+ * @return Index of the first variable name, or -1 on a usage error
+ *
+ * Option arguments may be attached ("-n5", "-d:") or separate
+ * ("-n 5", "-d :"). An empty -d delimiter means NUL.
+ */
+static int	read_opts(t_cmds *cmd, t_readopt *opt)
+{
+	int		i;
+	int		j;
+	char	flag;
+	char	*arg;
+
+	i = 1;
+	while (cmd->str[i] && cmd->str[i][0] == '-' && cmd->str[i][1])
+	{
+		flag = cmd->str[i][1];
+		arg = cmd->str[i] + 2;
+		if (flag == 'r' && !*arg)
+			opt->raw = true;
+		else if (flag != 'd' && flag != 'n')
+			return (-1);
+		else if (!*arg && !cmd->str[++i])
+			return (-1);
+		if (flag != 'r' && !*arg)
+			arg = cmd->str[i];
+		j = 0;
+		while (flag == 'n' && ft_isdigit(arg[j]))
+			j++;
+		if (flag == 'n' && (j == 0 || arg[j]))
+			return (-1);
+		if (flag == 'n')
+			opt->max = ft_atoi(arg);
+		if (flag == 'd')
+			opt->delim = arg[0];
+		i++;
+	}
+	return (i);
+}
+
+/**
+ * @brief Read one record from stdin into the per-line arena
+ * @param shell Shell state owning the readahead buffer and the arena
+ * @param opt Options given to read
+ * @param status Set to 0 if the record ended normally, 1 at end of input
+ * @return NUL-terminated record, without its delimiter
+ *
+ * Without -r a backslash quotes the next character, and a
+ * backslash-newline pair is removed (line continuation). NUL bytes are
+ * dropped, as bash does. With -n the record also ends after max
+ * characters.
+ */
+static char	*read_input(t_shell *shell, t_readopt *opt, int *status)
+{
+	char	*line;
+	size_t	len;
+	size_t	cap;
+	bool	esc;
+	char	c;
+
+	cap = 128;
+	line = arena_alloc(&shell->arena, cap);
+	len = 0;
+	esc = false;
+	*status = 1;
+	rd_begin(&shell->rd);
+	while (*status && (opt->max < 0 || (long)len < opt->max)
+		&& rd_getc(&shell->rd, &c) == 1)
+	{
+		if (!esc && !opt->raw && c == '\\')
+			esc = true;
+		else if (!esc && c == opt->delim)
+			*status = 0;
+		else
+		{
+			if (len + 1 == cap)
+			{
+				cap *= 2;
+				line = ft_memcpy(arena_alloc(&shell->arena, cap), line, len);
+			}
+			if (c && !(esc && c == '\n'))
+				line[len++] = c;
+			esc = false;
+		}
+	}
+	rd_end(&shell->rd);
+	line[len] = '\0';
+	if (opt->max >= 0 && (long)len == opt->max)
+		*status = 0;
+	return (line);
+}
+
+/**
+ * @brief Check that every operand of read is a valid variable name
+ * @param names Variable names given to read
+ * @return true if all names are valid, false after printing an error
+ */
+static bool	read_names(char **names)
+{
+	int	i;
+	int	j;
+
+	i = 0;
+	while (names[i])
+	{
+		j = 0;
+		while (names[i][j] == '_' || ft_isalnum(names[i][j]))
+			j++;
+		if (j == 0 || names[i][j] || ft_isdigit(names[i][0]))
+		{
+			diag("minishell: read: `%s': not a valid identifier\n", names[i]);
+			return (false);
+		}
+		i++;
+	}
+	return (true);
+}
+
+/**
+ * @brief Split a record into fields and assign them to variables
+ * @param shell Shell state holding the environment store
+ * @param names Variable names (REPLY gets the whole record if none)
+ * @param line Record read by read_input() (modified in place)
+ *
+ * Fields are separated by runs of spaces, tabs and newlines. Each name
+ * gets one field; the last name gets the rest of the record with its
+ * surrounding whitespace removed. Names left without a field are set
+ * to the empty string.
+ */
+static void	read_assign(t_shell *shell, char **names, char *line)
+{
+	char	*start;
+	char	*end;
+
+	if (!names[0])
+		return (env_set(shell, "REPLY", line));
+	while (*names)
+	{
+		while (*line && ft_strchr(" \t\n", *line))
+			line++;
+		start = line;
+		while (*line && (!names[1] || !ft_strchr(" \t\n", *line)))
+			line++;
+		end = line;
+		while (!names[1] && end > start && ft_strchr(" \t\n", end[-1]))
+			end--;
+		if (*line)
+			line++;
+		*end = '\0';
+		env_set(shell, *names++, start);
+	}
+}
+
+/**
+ * @brief Implementation of read builtin command
+ * @param cmd Command structure containing arguments
+ * @param shell Shell state owning the readahead buffer
+ * @return 0 on success, 1 at end of input or for a bad name, 2 for a
+ *         usage error
+ *
+ * Usage: read [-r] [-d delim] [-n nchars] [name ...]
+ *
+ * Input comes from stdin, so `read line < file` and a last-stage read
+ * under `shopt -s lastpipe` both set variables of the shell itself.
+ * Regular files are read in blocks through the readahead buffer (see
+ * rd_begin); everything else is read byte by byte.
+ *
+ * Examples:
+ *   read a b rest < file    -> a, b = first two words, rest = the rest
+ *   read -r -d : field      -> field = input up to the first ':'
+ *   read -n 4 code          -> code = next four characters
+ */
+int	ft_read(t_cmds *cmd, t_shell *shell)
+{
+	t_readopt	opt;
+	char		*line;
+	int			status;
+	int			i;
+
+	opt.raw = false;
+	opt.delim = '\n';
+	opt.max = -1;
+	i = read_opts(cmd, &opt);
+	if (i == -1)
+	{
+		diag("minishell: read: usage: read [-r] [-d delim] "
+			"[-n nchars] [name ...]\n");
+		return (2);
+	}
+	if (!read_names(cmd->str + i))
+		return (1);
+	line = read_input(shell, &opt, &status);
+	read_assign(shell, cmd->str + i, line);
+	return (status);
+}
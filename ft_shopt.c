@@ -0,0 +1,95 @@
+#include "minishell.h"
+#include "libft.h"
+
+/**
+ * @brief Find the bit of a shell option from its name
+ * @param name Option name as given to shopt
+ * @return Option bit (OPT_*), or 0 if the name is unknown
+ */
+static int	shopt_bit(const char *name)
+{
+	if (ft_strncmp(name, "lastpipe", 9) == 0)
+		return (OPT_LASTPIPE);
+	if (ft_strncmp(name, "joblimit", 9) == 0)
+		return (OPT_JOBLIMIT);
+	if (ft_strncmp(name, "bigpipe", 8) == 0)
+		return (OPT_BIGPIPE);
+	return (0);
+}
+
+/**
+ * @brief Print one option in bash `shopt` format
+ * @param shell Shell state holding the option bits
+ * @param name Option name
+ * @param bit Option bit
+ */
+static void	print_opt(t_shell *shell, const char *name, int bit)
+{
+	size_t	len;
+
+	len = ft_strlen(name);
+	out_puts(&shell->out, name);
+	while (len++ < 15)
+		out_putc(&shell->out, ' ');
+	out_putc(&shell->out, '\t');
+	if (shell->opts & bit)
+		out_puts(&shell->out, "on\n");
+	else
+		out_puts(&shell->out, "off\n");
+}
+
+/**
+ * @brief Implementation of shopt built-in command
+ * @param cmd Command structure containing arguments
+ * @param shell Shell state holding the option bits
+ * @return 0 on success, 1 for an unknown option name
+ *
+ * Usage:
+ *   shopt               -> list every option and its state
+ *   shopt -s name ...   -> enable options
+ *   shopt -u name ...   -> disable options
+ *   shopt name ...      -> show the given options
+ *
+ * Options:
+ *   bigpipe   give pipeline pipes MINISHELL_PIPE_SIZE bytes (default
+ *             1MiB) of buffer, see pipe_size()
+ *   joblimit  keep at most MINISHELL_JOBS (default: online CPUs)
+ *             background jobs running, see job_throttle()
+ *   lastpipe  run a built-in last pipeline stage in the shell itself
+ */
+int	ft_shopt(t_cmds *cmd, t_shell *shell)
+{
+	int		i;
+	int		bit;
+	char	mode;
+
+	i = 1;
+	mode = 0;
+	if (cmd->str[1] && (ft_strncmp(cmd->str[1], "-s", 3) == 0
+			|| ft_strncmp(cmd->str[1], "-u", 3) == 0))
+		mode = cmd->str[i++][1];
+	if (!cmd->str[i] && !mode)
+	{
+		print_opt(shell, "bigpipe", OPT_BIGPIPE);
+		print_opt(shell, "joblimit", OPT_JOBLIMIT);
+		print_opt(shell, "lastpipe", OPT_LASTPIPE);
+	}
+	while (cmd->str[i])
+	{
+		bit = shopt_bit(cmd->str[i]);
+		if (!bit)
+		{
+			diag("minishell: shopt: %s: invalid shell option name\n",
+				cmd->str[i]);
+			return (1);
+		}
+		if (mode == 's')
+			shell->opts |= bit;
+		else if (mode == 'u')
+			shell->opts &= ~bit;
+		else
+			print_opt(shell, cmd->str[i], bit);
+		i++;
+	}
+	return (0);
+}
@@ -0,0 +1,117 @@
+#include "minishell.h"
+#include "libft.h"
+
+/**
+ * @brief Compute the bucket index of a command name (djb2)
+ * @param name Command name to hash
+ * @return Bucket index in the range [0, HASH_SIZE)
+ */
+static unsigned int	hash_key(const char *name)
+{
+	unsigned int	key;
+
+	key = 5381;
+	while (*name)
+		key = key * 33 + (unsigned char)*name++;
+	return (key % HASH_SIZE);
+}
+
+/**
+ * @brief Look up the remembered location of a command
+ * @param shell Shell state owning the command hash table
+ * @param name Command name as typed by the user (no '/')
+ * @return Path stored in the table, or NULL if unknown or stale
+ *
+ * A hit increments the entry's hit counter (shown by `hash`).
+ * Entries whose file has disappeared are treated as misses so the
+ * caller falls back to a PATH search, which then overwrites them.
+ */
+char	*hash_lookup(t_shell *shell, const char *name)
+{
+	t_hash	*entry;
+
+	entry = shell->hash[hash_key(name)];
+	while (entry && ft_strncmp(entry->name, name, ft_strlen(name) + 1))
+		entry = entry->next;
+	if (!entry || access(entry->path, F_OK) != 0)
+		return (NULL);
+	entry->hits++;
+	return (entry->path);
+}
+
+/**
+ * @brief Remember the resolved path of a command
+ * @param shell Shell state owning the command hash table
+ * @param name Command name used as key (duplicated)
+ * @param path Allocated absolute path, ownership moves to the table
+ * @return The stored path, owned by the table (do not free)
+ *
+ * An existing entry for the same name has its path replaced and its
+ * hit counter reset, like bash does when it re-searches PATH.
+ */
+char	*hash_insert(t_shell *shell, const char *name, char *path)
+{
+	t_hash			*entry;
+	unsigned int	key;
+
+	key = hash_key(name);
+	entry = shell->hash[key];
+	while (entry && ft_strncmp(entry->name, name, ft_strlen(name) + 1))
+		entry = entry->next;
+	if (entry)
+		free(entry->path);
+	else
+	{
+		entry = ft_malloc(sizeof(t_hash));
+		entry->name = ft_strdup(name);
+		entry->next = shell->hash[key];
+		shell->hash[key] = entry;
+	}
+	entry->path = path;
+	entry->hits = 0;
+	return (entry->path);
+}
+
+/**
+ * @brief Forget every remembered command location (`hash -r`)
+ * @param shell Shell state owning the command hash table
+ */
+void	hash_clear(t_shell *shell)
+{
+	t_hash	*entry;
+	t_hash	*next;
+	int		i;
+
+	i = 0;
+	while (i < HASH_SIZE)
+	{
+		entry = shell->hash[i];
+		while (entry)
+		{
+			next = entry->next;
+			free(entry->name);
+			free(entry->path);
+			free(entry);
+			entry = next;
+		}
+		shell->hash[i++] = NULL;
+	}
+}
+
+/**
+ * @brief Invalidate PATH-derived state when PATH changes
+ * @param shell Shell state owning the command hash table
+ * @param var Name (or NAME=value string) of the variable being changed
+ *
+ * Must be called by export and unset for every variable they touch:
+ * a new PATH makes every remembered location potentially wrong, and
+ * the cached directory list from path_dirs() stale.
+ */
+void	hash_env_changed(t_shell *shell, const char *var)
+{
+	if (ft_strncmp(var, "PATH", 4) == 0 && (var[4] == '\0' || var[4] == '='))
+	{
+		hash_clear(shell);
+		path_drop(shell);
+	}
+}
@@ -0,0 +1,143 @@
+#include "minishell.h"
+#include "libft.h"
+#include <errno.h>
+#include <sys/mman.h>
+
+/**
+ * @brief Write as much of the body as the pipe accepts without blocking
+ * @param fd Heredoc pipe; the writer keeps only the write end
+ * @param hd Heredoc body
+ * @return Number of bytes written
+ */
+static size_t	write_some(int fd, t_heredoc *hd)
+{
+	size_t	done;
+	ssize_t	n;
+	int		flags;
+
+	flags = fcntl(fd, F_GETFL);
+	fcntl(fd, F_SETFL, flags | O_NONBLOCK);
+	done = 0;
+	while (done < hd->len)
+	{
+		n = write(fd, hd->buf + done, hd->len - done);
+		if (n == -1 && errno == EINTR)
+			continue ;
+		if (n == -1)
+			break ;
+		done += n;
+	}
+	fcntl(fd, F_SETFL, flags);
+	return (done);
+}
+
+/**
+ * @brief Feed the rest of a large body from a detached writer process
+ * @param fd Heredoc pipe; the writer keeps only the write end
+ * @param hd Heredoc body
+ * @param done Bytes already in the pipe
+ *
+ * The intermediate child exits at once and is reaped here; the writer
+ * it leaves behind is adopted by init, so nothing has to track it. It
+ * blocks on the pipe while the reader consumes, and dies by SIGPIPE if
+ * the reader exits early, so the shell never waits on pipe capacity.
+ * The writer closes every descriptor but fd[1]: an inherited end of
+ * another pipe (a second heredoc, a pipeline stage) would keep that
+ * pipe's reader from ever seeing EOF.
+ */
+static void	feed_helper(int fd[2], t_heredoc *hd, size_t done)
+{
+	pid_t	pid;
+	ssize_t	n;
+
+	pid = ft_fork();
+	if (pid == 0)
+	{
+		signal(SIGPIPE, SIG_DFL);
+		if (ft_fork() != 0)
+			exit(0);
+		close_range(0, fd[1] - 1, 0);
+		close_range(fd[1] + 1, ~0U, 0);
+		while (done < hd->len)
+		{
+			n = write(fd[1], hd->buf + done, hd->len - done);
+			if (n == -1 && errno != EINTR)
+				exit(1);
+			if (n > 0)
+				done += n;
+		}
+		exit(0);
+	}
+	waitpid(pid, NULL, 0);
+}
+
+/**
+ * @brief Store a heredoc body in an anonymous memory file
+ * @param hd Heredoc body
+ * @return Descriptor positioned at the start of the body, or -1 if
+ *         memfd_create() is unavailable or failed
+ *
+ * The file lives only in memory and disappears with its last
+ * descriptor: no path, no unlink(), nothing to clean up on SIGINT.
+ */
+static int	heredoc_memfd(t_heredoc *hd)
+{
+	int		fd;
+	size_t	done;
+	ssize_t	n;
+
+	fd = memfd_create("heredoc", MFD_CLOEXEC);
+	done = 0;
+	while (fd != -1 && done < hd->len)
+	{
+		n = write(fd, hd->buf + done, hd->len - done);
+		if (n > 0)
+			done += n;
+		else if (n == -1 && errno != EINTR)
+		{
+			close(fd);
+			fd = -1;
+		}
+	}
+	if (fd != -1)
+		lseek(fd, 0, SEEK_SET);
+	return (fd);
+}
+
+/**
+ * @brief Turn a collected heredoc body into a readable descriptor
+ * @param hd Heredoc body (freed and reset by this call)
+ * @return Read descriptor to dup2() onto the command's stdin, or -1
+ *
+ * Storage backends:
+ * - Bodies up to PIPE_BUF bytes go through an anonymous pipe, which
+ *   always holds them without blocking
+ * - Larger bodies go to a memfd_create() memory file
+ * - Without memfd support, a pipe fed by a detached writer
+ *
+ * None of them touches the filesystem.
+ */
+int	heredoc_open(t_heredoc *hd)
+{
+	int		fd[2];
+	size_t	done;
+
+	fd[0] = -1;
+	if (hd->len > PIPE_BUF)
+		fd[0] = heredoc_memfd(hd);
+	if (fd[0] == -1)
+	{
+		if (pipe2(fd, O_CLOEXEC) == -1)
+			diag("heredoc: %m\n");
+		else
+		{
+			done = write_some(fd[1], hd);
+			if (done < hd->len)
+				feed_helper(fd, hd, done);
+			close(fd[1]);
+		}
+	}
+	free(hd->buf);
+	ft_bzero(hd, sizeof(*hd));
+	return (fd[0]);
+}
@@ -0,0 +1,55 @@
+#include "minishell.h"
+#include "libft.h"
+
+/**
+ * @brief Append one input line to an in-memory heredoc body
+ * @param hd Heredoc body being collected (zero-initialized at start)
+ * @param line Line read from the input, without its newline
+ *
+ * The buffer doubles when full, so collecting a body of n bytes costs
+ * O(log n) allocations and no filesystem access.
+ */
+void	heredoc_append(t_heredoc *hd, const char *line)
+{
+	size_t	len;
+	char	*grown;
+
+	len = ft_strlen(line);
+	if (hd->len + len + 1 > hd->cap)
+	{
+		hd->cap = hd->cap * 2 + len + 1;
+		grown = ft_malloc(hd->cap);
+		if (hd->buf)
+			ft_memcpy(grown, hd->buf, hd->len);
+		free(hd->buf);
+		hd->buf = grown;
+	}
+	ft_memcpy(hd->buf + hd->len, line, len);
+	hd->buf[hd->len + len] = '\n';
+	hd->len += len + 1;
+}
+
+/**
+ * @brief Put a stage's in-memory heredoc body on its stdin
+ * @param cmd Stage being set up, after handle_redirections()
+ * @return false if no descriptor could be made for the body
+ *
+ * handle_heredocs() only collects the bodies (cmd->heredoc, NULL for a
+ * stage without `<<`); the descriptor is made here, when the stage is
+ * launched, so a stage without a heredoc never waits for one. The body
+ * is released either way.
+ */
+bool	heredoc_stdin(t_cmds *cmd)
+{
+	int	fd;
+
+	if (!cmd->heredoc)
+		return (true);
+	fd = heredoc_open(cmd->heredoc);
+	free(cmd->heredoc);
+	cmd->heredoc = NULL;
+	if (fd == -1)
+		return (false);
+	ft_dup2(fd, STDIN);
+	return (true);
+}
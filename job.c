@@ -0,0 +1,152 @@
+#include "minishell.h"
+#include "libft.h"
+#include <errno.h>
+
+/**
+ * @brief Record a just-launched background pipeline in the job table
+ * @param shell Shell state containing the launched command list
+ *
+ * Copies the pid of every started stage, so the job outlives the
+ * command list. Prints "[id] pid" like bash, pid being the last stage
+ * that was started. A pipeline where no stage started (`nosuchcmd &`)
+ * has already printed its diagnostic and gets no job at all.
+ */
+void	job_add(t_shell *shell)
+{
+	t_job	*job;
+	t_job	**last;
+	t_cmds	*curr;
+	int		started;
+
+	started = running_stages(shell);
+	if (started == 0)
+		return ;
+	job = ft_malloc(sizeof(t_job));
+	ft_bzero(job, sizeof(t_job));
+	job->id = 1;
+	last = &shell->jobs;
+	while (*last && (*last)->id >= job->id)
+	{
+		job->id = (*last)->id + 1;
+		last = &(*last)->next;
+	}
+	job->pgid = shell->pgid;
+	job->name = job_name(shell);
+	job->pids = ft_malloc(sizeof(pid_t) * (started + 1));
+	curr = shell->cmds;
+	while (curr)
+	{
+		if (curr->pid != -1)
+			job->pids[job->left++] = curr->pid;
+		job->status = curr->exit_status;
+		job->last = curr->pid;
+		curr = curr->next;
+	}
+	job->npids = job->left;
+	*last = job;
+	diag("[%d] %d\n", job->id, (int)job->pids[job->npids - 1]);
+}
+
+/**
+ * @brief Record a reaped child in the background job it belongs to
+ * @param shell Shell state holding the job table
+ * @param pid Process ID returned by wait4()/waitpid()
+ * @param status Raw wait status of the child
+ *
+ * The job's status is the one of its last stage, as for a foreground
+ * pipeline. Children that belong to no job are ignored.
+ */
+void	job_child(t_shell *shell, pid_t pid, int status)
+{
+	t_job	*job;
+	int		i;
+
+	job = shell->jobs;
+	while (job)
+	{
+		i = 0;
+		while (i < job->npids && job->pids[i] != pid)
+			i++;
+		if (i < job->npids)
+		{
+			job->left--;
+			if (pid == job->last)
+				job->status = wait_status(status);
+			return ;
+		}
+		job = job->next;
+	}
+}
+
+/**
+ * @brief Check if a process belongs to a job
+ * @param job Job to search
+ * @param pid Process ID to look for
+ * @return true if pid is one of the job's processes
+ */
+static bool	job_has_pid(t_job *job, pid_t pid)
+{
+	int	i;
+
+	i = 0;
+	while (i < job->npids)
+		if (job->pids[i++] == pid)
+			return (true);
+	return (false);
+}
+
+/**
+ * @brief Look up a job from a jobs/wait/fg operand
+ * @param shell Shell state holding the job table
+ * @param spec "%n" for job n, "%%", "%+" or NULL for the current (most
+ *             recent) job, or the pid of any of the job's processes
+ * @return The job, or NULL if there is no such job
+ */
+t_job	*job_find(t_shell *shell, const char *spec)
+{
+	t_job	*job;
+	t_job	*current;
+
+	current = NULL;
+	job = shell->jobs;
+	while (job)
+	{
+		if (spec && spec[0] == '%' && ft_isdigit(spec[1])
+			&& ft_atoi(spec + 1) == job->id)
+			return (job);
+		if (spec && spec[0] != '%' && job_has_pid(job, ft_atoi(spec)))
+			return (job);
+		current = job;
+		job = job->next;
+	}
+	if (!spec || ft_strncmp(spec, "%%", 3) == 0
+		|| ft_strncmp(spec, "%+", 3) == 0)
+		return (current);
+	return (NULL);
+}
+
+/**
+ * @brief Block until every process of a job has terminated
+ * @param shell Shell state holding the job table
+ * @param job Job to wait for
+ * @return Exit status of the job (its last stage)
+ *
+ * Other children reaped meanwhile are recorded in their own job, so
+ * nothing is lost while waiting.
+ */
+int	job_wait(t_shell *shell, t_job *job)
+{
+	pid_t	pid;
+	int		status;
+
+	while (job->left > 0)
+	{
+		pid = waitpid(-1, &status, 0);
+		if (pid == -1 && errno == EINTR)
+			continue ;
+		if (pid == -1)
+			break ;
+		job_child(shell, pid, status);
+	}
+	return (job->status);
+}
@@ -0,0 +1,77 @@
+#include "minishell.h"
+#include "libft.h"
+#include <errno.h>
+
+/**
+ * @brief Get the maximum number of background jobs allowed to run
+ * @param shell Shell state holding the environment
+ * @return MINISHELL_JOBS if set to a positive number, otherwise the
+ *         number of online CPUs (at least 1)
+ */
+static int	job_slots(t_shell *shell)
+{
+	char	*value;
+	long	n;
+
+	value = env_get(shell, "MINISHELL_JOBS");
+	n = 0;
+	if (value)
+		n = ft_atoi(value);
+	if (n <= 0)
+		n = sysconf(_SC_NPROCESSORS_ONLN);
+	if (n <= 0)
+		n = 1;
+	return (n);
+}
+
+/**
+ * @brief Count background jobs that still have running processes
+ * @param shell Shell state holding the job table
+ * @return Number of unfinished jobs
+ */
+static int	running_jobs(t_shell *shell)
+{
+	t_job	*job;
+	int		n;
+
+	n = 0;
+	job = shell->jobs;
+	while (job)
+	{
+		n += (job->left > 0);
+		job = job->next;
+	}
+	return (n);
+}
+
+/**
+ * @brief Wait for a free job slot before launching a background job
+ * @param shell Shell state holding the job table
+ *
+ * With `shopt -s joblimit`, a script starting one background job per
+ * line (`cmd1 &`, `cmd2 &`, ..., then `wait`) keeps at most job_slots()
+ * jobs in flight, like `xargs -P`: the launch blocks until any running
+ * job finishes (collected in finish order by waitpid(-1)). Finished
+ * jobs are then reported as usual by reap_jobs(). Only a trailing `&`
+ * makes a job (see bg_suffix()), so `cmd1 & cmd2 &` on one line is not
+ * split.
+ */
+void	job_throttle(t_shell *shell)
+{
+	pid_t	pid;
+	int		status;
+	int		slots;
+
+	if (!(shell->opts & OPT_JOBLIMIT))
+		return ;
+	slots = job_slots(shell);
+	while (running_jobs(shell) >= slots)
+	{
+		pid = waitpid(-1, &status, 0);
+		if (pid == -1 && errno == EINTR)
+			continue ;
+		if (pid == -1)
+			break ;
+		job_child(shell, pid, status);
+	}
+}
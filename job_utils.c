@@ -0,0 +1,137 @@
+#include "minishell.h"
+#include "libft.h"
+
+/**
+ * @brief Strip a trailing `&` word and mark the pipeline as background
+ * @param shell Shell state containing the parsed command list
+ * @return true if the pipeline has to run in the background
+ *
+ * Resets shell->pgid so the first launched stage starts a new process
+ * group for the job.
+ */
+bool	bg_suffix(t_shell *shell)
+{
+	t_cmds	*last;
+	int		i;
+
+	shell->bg = false;
+	shell->pgid = 0;
+	last = shell->cmds;
+	while (last->next)
+		last = last->next;
+	i = 0;
+	while (last->str[i] && last->str[i + 1])
+		i++;
+	if (!last->str[i] || ft_strncmp(last->str[i], "&", 2) != 0)
+		return (false);
+	free(last->str[i]);
+	last->str[i] = NULL;
+	shell->bg = true;
+	return (true);
+}
+
+/**
+ * @brief Put a launched background stage into the job's process group
+ * @param shell Shell state describing the pipeline being launched
+ * @param pid Process ID of the stage (0 in a forked child)
+ *
+ * Called on both sides of each launch (parent and forked child) so the
+ * group exists before either one goes on; spawned stages get the same
+ * group through POSIX_SPAWN_SETPGROUP. Keyboard signals then only reach
+ * the foreground, and fg can hand the terminal to the job.
+ */
+void	job_pgrp(t_shell *shell, pid_t pid)
+{
+	if (!shell->bg || pid == -1)
+		return ;
+	setpgid(pid, shell->pgid);
+	if (pid != 0 && shell->pgid == 0)
+		shell->pgid = pid;
+}
+
+/**
+ * @brief Build the job name shown by jobs and fg ("a x | b")
+ * @param shell Shell state containing the launched command list
+ * @return Allocated command line of the job
+ */
+char	*job_name(t_shell *shell)
+{
+	t_cmds	*curr;
+	char	*name;
+	int		i;
+
+	name = ft_strdup("");
+	curr = shell->cmds;
+	while (curr)
+	{
+		i = 0;
+		while (curr->str[i])
+		{
+			if (*name)
+				name = ft_strjoin_free(name, " ");
+			name = ft_strjoin_free(name, curr->str[i++]);
+		}
+		if (curr->next)
+			name = ft_strjoin_free(name, " |");
+		curr = curr->next;
+	}
+	return (name);
+}
+
+/**
+ * @brief Remove a job from the job table and free it
+ * @param shell Shell state holding the job table
+ * @param job Job to remove
+ */
+void	job_remove(t_shell *shell, t_job *job)
+{
+	t_job	**link;
+
+	link = &shell->jobs;
+	while (*link && *link != job)
+		link = &(*link)->next;
+	if (*link)
+		*link = job->next;
+	free(job->pids);
+	free(job->name);
+	free(job);
+}
+
+/**
+ * @brief Collect finished background children without blocking
+ * @param shell Shell state holding the job table
+ * @param notify true to report and forget jobs that are done
+ *
+ * Called before every command line, so background jobs never linger
+ * as zombies and their completion is reported like bash does, on
+ * stderr so it never ends up in redirected or piped output:
+ *   [1]  Done		sleep 1 &
+ *   [2]  Exit 3		false &
+ */
+void	reap_jobs(t_shell *shell, bool notify)
+{
+	t_job	*job;
+	t_job	*next;
+	pid_t	pid;
+	int		status;
+
+	pid = waitpid(-1, &status, WNOHANG);
+	while (pid > 0)
+	{
+		job_child(shell, pid, status);
+		pid = waitpid(-1, &status, WNOHANG);
+	}
+	job = shell->jobs;
+	while (notify && job)
+	{
+		next = job->next;
+		if (job->left == 0 && job->status == 0)
+			diag("[%d]  Done\t\t%s &\n", job->id, job->name);
+		else if (job->left == 0)
+			diag("[%d]  Exit %d\t\t%s &\n", job->id, job->status,
+				job->name);
+		if (job->left == 0)
+			job_remove(shell, job);
+		job = next;
+	}
+}
@@ -0,0 +1,106 @@
+#include "minishell.h"
+#include "libft.h"
+#include <errno.h>
+
+/**
+ * @brief Write out everything buffered for built-in output
+ * @param out Output buffer of the shell
+ * @return 0 on success, -1 if write() failed (buffer is dropped)
+ *
+ * Called once by execute_builtin() after every built-in, so pending
+ * output always reaches out->fd before single_cmd() restores stdio.
+ * out->fd is the built-in I/O target: STDOUT unless the caller
+ * points built-in output somewhere else (see shell_init()). With
+ * out->sink set, output is appended to that buffer instead of written
+ * (command substitution, see capture()).
+ */
+int	out_flush(t_outbuf *out)
+{
+	size_t	done;
+	ssize_t	n;
+
+	if (out->sink)
+	{
+		capture_append(out->sink, out->buf, out->len);
+		out->len = 0;
+		return (0);
+	}
+	done = 0;
+	while (done < out->len)
+	{
+		n = write(out->fd, out->buf + done, out->len - done);
+		if (n == -1 && errno == EINTR)
+			continue ;
+		if (n == -1)
+		{
+			out->len = 0;
+			return (-1);
+		}
+		done += n;
+	}
+	out->len = 0;
+	return (0);
+}
+
+/**
+ * @brief Append a string to the built-in output buffer
+ * @param out Output buffer of the shell
+ * @param s String to append (may be longer than the buffer)
+ *
+ * The buffer is flushed whenever it fills up, so memory use stays at
+ * OUTBUF_SIZE regardless of how much a built-in prints.
+ */
+void	out_puts(t_outbuf *out, const char *s)
+{
+	size_t	len;
+	size_t	room;
+
+	len = ft_strlen(s);
+	while (len > 0)
+	{
+		if (out->len == OUTBUF_SIZE)
+			out_flush(out);
+		room = OUTBUF_SIZE - out->len;
+		if (room > len)
+			room = len;
+		ft_memcpy(out->buf + out->len, s, room);
+		out->len += room;
+		s += room;
+		len -= room;
+	}
+}
+
+/**
+ * @brief Append a single character to the built-in output buffer
+ * @param out Output buffer of the shell
+ * @param c Character to append
+ */
+void	out_putc(t_outbuf *out, char c)
+{
+	if (out->len == OUTBUF_SIZE)
+		out_flush(out);
+	out->buf[out->len++] = c;
+}
+
+/**
+ * @brief Append a decimal number, right-aligned to a minimum width
+ * @param out Output buffer of the shell
+ * @param n Non-negative number to append
+ * @param width Minimum field width, padded with spaces on the left
+ */
+void	out_putnbr(t_outbuf *out, unsigned long n, int width)
+{
+	char	digits[24];
+	int		len;
+
+	len = 0;
+	while (len == 0 || n > 0)
+	{
+		digits[len++] = '0' + n % 10;
+		n /= 10;
+	}
+	while (width-- > len)
+		out_putc(out, ' ');
+	while (len > 0)
+		out_putc(out, digits[--len]);
+}
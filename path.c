@@ -0,0 +1,121 @@
+#include "minishell.h"
+#include "libft.h"
+#include <stdlib.h>
+#include <sys/stat.h>
+
+/**
+ * @brief Open an O_PATH fd for one PATH directory, when it is safe to
+ * @param dir PATH entry
+ * @return Directory fd, or -1 to keep resolving the entry by string
+ *
+ * Relative entries (like ".") name a different directory after every
+ * cd. Entries going through a symlink (or spelled non-canonically)
+ * can be retargeted without the directory itself changing, which an
+ * fd would never notice. Entries that cannot be opened yet may be
+ * created later. All of these stay -1.
+ */
+static int	dir_open(const char *dir)
+{
+	char	*real;
+	int		fd;
+
+	if (dir[0] != '/')
+		return (-1);
+	real = realpath(dir, NULL);
+	fd = -1;
+	if (real && ft_strncmp(real, dir, ft_strlen(dir) + 1) == 0)
+		fd = open(dir, O_PATH | O_DIRECTORY | O_CLOEXEC);
+	free(real);
+	return (fd);
+}
+
+/**
+ * @brief Open an O_PATH directory fd for every cached PATH entry
+ * @param shell Shell state holding the split PATH in shell->path
+ */
+static void	open_dirs(t_shell *shell)
+{
+	int	n;
+
+	n = 0;
+	while (shell->path[n])
+		n++;
+	shell->path_fd = ft_malloc((n + 1) * sizeof(int));
+	while (n--)
+		shell->path_fd[n] = dir_open(shell->path[n]);
+}
+
+/**
+ * @brief Get the PATH directories of the shell environment
+ * @param shell Shell state for environment access
+ * @return Cached array of PATH directories, or NULL if PATH is unset
+ *
+ * PATH is split once and kept in shell->path until it changes
+ * (hash_env_changed() calls path_drop()). shell->path_fd holds the
+ * matching pre-opened directory fds. Both belong to the shell.
+ */
+char	**path_dirs(t_shell *shell)
+{
+	char	*path;
+
+	if (shell->path)
+		return (shell->path);
+	path = env_get(shell, "PATH");
+	if (path)
+	{
+		shell->path = ft_split(path, ':');
+		open_dirs(shell);
+	}
+	return (shell->path);
+}
+
+/**
+ * @brief Check whether a PATH directory contains a command
+ * @param shell Shell state with the cached PATH from path_dirs()
+ * @param i Index of the PATH entry
+ * @param name Command name without any '/'
+ * @return true if dir/name exists
+ *
+ * With a directory fd the kernel only looks up name inside it, and
+ * no candidate string is built. A directory that was removed (and
+ * maybe recreated) since the fd was opened has no links left: one
+ * fstat() sees that, and the entry is reopened by name.
+ */
+bool	path_has(t_shell *shell, int i, const char *name)
+{
+	struct stat	st;
+
+	if (shell->path_fd[i] != -1
+		&& (fstat(shell->path_fd[i], &st) == -1 || st.st_nlink == 0))
+	{
+		close(shell->path_fd[i]);
+		shell->path_fd[i] = dir_open(shell->path[i]);
+	}
+	if (shell->path_fd[i] != -1)
+		return (faccessat(shell->path_fd[i], name, F_OK, 0) == 0);
+	return (access(arena_path(&shell->arena, shell->path[i], name),
+			F_OK) == 0);
+}
+
+/**
+ * @brief Forget the cached PATH directories and close their fds
+ * @param shell Shell state holding the PATH cache
+ */
+void	path_drop(t_shell *shell)
+{
+	int	i;
+
+	if (!shell->path)
+		return ;
+	i = 0;
+	while (shell->path[i])
+	{
+		if (shell->path_fd[i] != -1)
+			close(shell->path_fd[i]);
+		i++;
+	}
+	ft_free_arr(shell->path);
+	free(shell->path_fd);
+	shell->path = NULL;
+	shell->path_fd = NULL;
+}
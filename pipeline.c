@@ -0,0 +1,146 @@
+#include "minishell.h"
+#include "libft.h"
+
+/**
+ * @brief Get the buffer size for pipeline pipes
+ * @param shell Shell state holding the options and environment
+ * @return Size in bytes, or 0 for the kernel default
+ *
+ * Under `shopt -s bigpipe` pipes get MINISHELL_PIPE_SIZE bytes
+ * (PIPE_BIG when it is unset or not a positive number). Setting
+ * MINISHELL_PIPE_SIZE before the shell starts turns the option on.
+ */
+static int	pipe_size(t_shell *shell)
+{
+	char	*size;
+	int		n;
+
+	if (!(shell->opts & OPT_BIGPIPE))
+		return (0);
+	size = env_get(shell, "MINISHELL_PIPE_SIZE");
+	n = 0;
+	if (size)
+		n = ft_atoi(size);
+	if (n <= 0)
+		n = PIPE_BIG;
+	return (n);
+}
+
+/**
+ * @brief Create every pipe of the pipeline before the first fork
+ * @param shell Shell state containing the parsed command list
+ *
+ * Single pass over the command list: each command that has a next
+ * command gets its pipe in cmd->pipefd, the last one gets -1/-1.
+ * Every pid starts at -1, so stages never launched (shell->stop) are
+ * not waited for, and every rusage at zero, so `time -s` reports such
+ * stages consistently (reap_child() fills in the others).
+ * All ends are close-on-exec (see ft_pipe), so exec'd stages only keep
+ * the two ends they dup2() onto stdin/stdout. Their buffer size comes
+ * from pipe_size().
+ */
+void	open_pipeline(t_shell *shell)
+{
+	t_cmds	*curr;
+	int		size;
+
+	size = pipe_size(shell);
+	curr = shell->cmds;
+	while (curr)
+	{
+		curr->pid = -1;
+		ft_bzero(&curr->rusage, sizeof(curr->rusage));
+		curr->pipefd[0] = -1;
+		curr->pipefd[1] = -1;
+		if (curr->next)
+			ft_pipe(curr->pipefd, size);
+		curr = curr->next;
+	}
+}
+
+/**
+ * @brief Close every pipe end created by open_pipeline()
+ * @param shell Shell state containing the command list
+ *
+ * Called by the parent once all stages are launched, and by forked
+ * children (built-ins, which never exec) after wiring their own ends,
+ * so no reader is kept from seeing EOF by a stray writer.
+ */
+void	close_pipeline(t_shell *shell)
+{
+	t_cmds	*curr;
+
+	curr = shell->cmds;
+	while (curr && curr->pipefd[0] != -1)
+	{
+		close(curr->pipefd[0]);
+		close(curr->pipefd[1]);
+		curr->pipefd[0] = -1;
+		curr->pipefd[1] = -1;
+		curr = curr->next;
+	}
+}
+
+/**
+ * @brief Run a resolved built-in, or report an unknown command
+ * @param cmd Command to run, with stdio and redirections already set up
+ * @param shell Shell state for environment and configuration
+ */
+static void	parent_builtin(t_cmds *cmd, t_shell *shell)
+{
+	if (is_unresolved(cmd))
+	{
+		cmd_not_found(cmd);
+		g_return_value = 127;
+	}
+	else
+		execute_builtin(cmd, shell);
+}
+
+/**
+ * @brief Run a built-in or report an unknown command in the parent
+ * @param cmd Command to run (single command or last pipeline stage)
+ * @param prev_fd Read end of the previous pipe (or -1 for none)
+ * @param shell Shell state for environment and configuration
+ *
+ * Fast path: a command with no pipe input and no redirections already
+ * has the right stdio, so it runs as is (`export FOO=1` in a loop
+ * costs no dup/dup2 at all). Otherwise:
+ * 1. Save current stdin/stdout file descriptors
+ * 2. Connect stdin to the previous pipe, then close every pipe end so
+ *    the built-in sees EOF once the writers are done. Only a lastpipe
+ *    stage has pipes: single_cmd() runs before open_pipeline(), when
+ *    pipefd still holds the parser's zeroes
+ * 3. Apply any redirections (>, <, >>), then the heredoc body (<<)
+ * 4. Execute the built-in command or report "command not found"
+ * 5. Restore original stdin/stdout
+ *
+ * No child is created: cmd->pid is -1 and the status is stored in
+ * cmd->exit_status for ft_waitpid().
+ */
+void	run_in_parent(t_cmds *cmd, int prev_fd, t_shell *shell)
+{
+	int		save_stdin;
+	int		save_stdout;
+
+	if (prev_fd == -1 && !has_redirections(cmd))
+		parent_builtin(cmd, shell);
+	else
+	{
+		save_stdin = ft_dup(STDIN);
+		save_stdout = ft_dup(STDOUT);
+		if (prev_fd != -1)
+		{
+			dup2(prev_fd, STDIN);
+			close_pipeline(shell);
+		}
+		if (!handle_redirections(cmd, shell) || !heredoc_stdin(cmd))
+			g_return_value = 1;
+		else
+			parent_builtin(cmd, shell);
+		ft_dup2(save_stdin, STDIN);
+		ft_dup2(save_stdout, STDOUT);
+	}
+	cmd->pid = -1;
+	cmd->exit_status = g_return_value;
+}
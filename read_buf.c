@@ -0,0 +1,92 @@
+#include "minishell.h"
+#include "libft.h"
+#include <errno.h>
+#include <sys/stat.h>
+
+/**
+ * @brief Prepare the readahead buffer of stdin for one `read`
+ * @param rd Readahead state of the shell
+ *
+ * Regular files are read in RDBUF_SIZE blocks. What `read` leaves in
+ * the buffer stays valid for the next call as long as stdin is still
+ * the same, unchanged file at an offset inside the buffer, so a loop
+ * of reads costs one pread() per block instead of one read() per byte.
+ * Pipes, terminals and other streams cannot give back what was read
+ * too far, so POSIX requires them to be read one byte at a time.
+ */
+void	rd_begin(t_rdbuf *rd)
+{
+	struct stat	st;
+	off_t		cur;
+
+	cur = lseek(STDIN, 0, SEEK_CUR);
+	rd->seekable = (cur != -1 && fstat(STDIN, &st) == 0
+			&& S_ISREG(st.st_mode));
+	if (!rd->seekable)
+	{
+		rd->len = 0;
+		rd->pos = 0;
+		return ;
+	}
+	if (st.st_dev != rd->dev || st.st_ino != rd->ino
+		|| st.st_size != rd->size || st.st_mtime != rd->mtime
+		|| cur < rd->start || cur > rd->start + (off_t)rd->len)
+	{
+		rd->dev = st.st_dev;
+		rd->ino = st.st_ino;
+		rd->size = st.st_size;
+		rd->mtime = st.st_mtime;
+		rd->start = cur;
+		rd->len = 0;
+	}
+	rd->pos = cur - rd->start;
+}
+
+/**
+ * @brief Get the next input byte of stdin
+ * @param rd Readahead state prepared by rd_begin()
+ * @param c Receives the byte
+ * @return 1 for a byte, 0 at end of input, -1 on read error
+ */
+int	rd_getc(t_rdbuf *rd, char *c)
+{
+	ssize_t	n;
+
+	n = -1;
+	while (rd->seekable && rd->pos == rd->len && n == -1)
+	{
+		n = pread(STDIN, rd->buf, RDBUF_SIZE, rd->start + rd->len);
+		if (n == -1 && errno != EINTR)
+			return (-1);
+		if (n == 0)
+			return (0);
+		if (n > 0)
+		{
+			rd->start += rd->len;
+			rd->len = n;
+			rd->pos = 0;
+		}
+	}
+	if (rd->seekable)
+	{
+		*c = rd->buf[rd->pos++];
+		return (1);
+	}
+	n = read(STDIN, c, 1);
+	while (n == -1 && errno == EINTR)
+		n = read(STDIN, c, 1);
+	return (n);
+}
+
+/**
+ * @brief Leave stdin positioned right after the consumed input
+ * @param rd Readahead state used by the finished `read`
+ *
+ * The file offset is what any later command reading the same stdin
+ * sees, so it must not include the readahead.
+ */
+void	rd_end(t_rdbuf *rd)
+{
+	if (rd->seekable)
+		lseek(STDIN, rd->start + rd->pos, SEEK_SET);
+}
@@ -0,0 +1,72 @@
+#include "minishell.h"
+#include "libft.h"
+
+/**
+ * @brief Convert a raw wait status into a shell exit status
+ * @param status Status returned by wait4()/waitpid()
+ * @return Exit code for a normal exit, 128 + signal number otherwise
+ *
+ * Signal termination uses the conventional exit codes:
+ * - SIGINT (Ctrl-C): 130
+ * - SIGQUIT (Ctrl-\): 131
+ */
+int	wait_status(int status)
+{
+	if (WIFEXITED(status))
+		return (WEXITSTATUS(status));
+	if (WIFSIGNALED(status))
+		return (128 + WTERMSIG(status));
+	return (status);
+}
+
+/**
+ * @brief Record a reaped child in the stage it belongs to
+ * @param shell Shell state containing the current command list
+ * @param pid Process ID returned by wait4()
+ * @param status Raw wait status of the child
+ * @param ru Resource usage of the child
+ * @return true if the child was a stage of the current pipeline
+ *
+ * The stage keeps its exit status in cmd->exit_status and its usage
+ * in cmd->rusage; cmd->pid becomes -1 so it is never waited twice.
+ * A stage killed by SIGINT or SIGQUIT sets shell->stop right away,
+ * while the rest of the pipeline is still being reaped.
+ */
+bool	reap_child(t_shell *shell, pid_t pid, int status, struct rusage *ru)
+{
+	t_cmds	*curr;
+
+	curr = shell->cmds;
+	while (curr && curr->pid != pid)
+		curr = curr->next;
+	if (!curr)
+		return (false);
+	curr->exit_status = wait_status(status);
+	if (curr->exit_status == 130 || curr->exit_status == 131)
+		shell->stop = true;
+	curr->rusage = *ru;
+	curr->stamp.reap = trace_now(shell);
+	curr->pid = -1;
+	return (true);
+}
+
+/**
+ * @brief Count the stages of the pipeline that are still running
+ * @param shell Shell state containing the current command list
+ * @return Number of stages with a child process not yet reaped
+ */
+int	running_stages(t_shell *shell)
+{
+	t_cmds	*curr;
+	int		n;
+
+	n = 0;
+	curr = shell->cmds;
+	while (curr)
+	{
+		if (curr->pid != -1)
+			n++;
+		curr = curr->next;
+	}
+	return (n);
+}
@@ -0,0 +1,65 @@
+#include "minishell.h"
+#include "libft.h"
+
+/**
+ * @brief Check if a command has to be looked up in PATH
+ * @param cmd Command structure containing the command name
+ * @return true for non-empty names without '/' that are not built-ins
+ */
+static bool	needs_path(t_cmds *cmd)
+{
+	if (!cmd->str[0] || cmd->str[0][0] == '\0')
+		return (false);
+	if (ft_strchr(cmd->str[0], '/') || is_builtin(cmd))
+		return (false);
+	return (true);
+}
+
+/**
+ * @brief Resolve PATH commands of the whole pipeline in the parent
+ * @param shell Shell state containing parsed commands and environment
+ *
+ * Runs once per command line before anything forks, so every lookup
+ * goes through the parent's command hash table and PATH is split at
+ * most once per new command name instead of once per child.
+ *
+ * Tags cmd->builtin with the built-in id of the command (BI_NONE for
+ * external commands), and sets cmd->path to the resolved location
+ * (owned by the hash table), or NULL for built-ins, path-based names
+ * and unknown commands.
+ */
+void	resolve_cmds(t_shell *shell)
+{
+	t_cmds	*curr;
+
+	curr = shell->cmds;
+	while (curr)
+	{
+		curr->builtin = builtin_id(curr->str[0]);
+		curr->path = NULL;
+		if (needs_path(curr))
+			curr->path = find_in_path(shell, curr->str[0]);
+		curr = curr->next;
+	}
+}
+
+/**
+ * @brief Check if PATH resolution failed for a command
+ * @param cmd Command structure after resolve_cmds()
+ * @return true if the command needed a PATH lookup and none was found
+ *
+ * Such commands can be reported without forking a child for them.
+ */
+bool	is_unresolved(t_cmds *cmd)
+{
+	return (needs_path(cmd) && cmd->path == NULL);
+}
+
+/**
+ * @brief Print the "command not found" diagnostic for a command
+ * @param cmd Command structure containing the command name
+ */
+void	cmd_not_found(t_cmds *cmd)
+{
+	diag("minishell: %s: command not found\n", cmd->str[0]);
+}
@@ -0,0 +1,143 @@
+#include "minishell.h"
+#include "libft.h"
+#include <errno.h>
+#include <spawn.h>
+#include <string.h>
+
+/**
+ * @brief Check if a pipeline stage can be launched without fork()
+ * @param cmd Command structure after resolve_cmds()
+ * @param shell Shell state describing the pipeline being launched
+ * @return true for external commands and for unresolved command names
+ *
+ * Built-ins still need a forked subshell, and so do the error paths of
+ * execute_currdir() (empty name, missing path-based command). Commands
+ * that could not be resolved only need their diagnostic, which the
+ * parent prints itself.
+ *
+ * A spawned stage has its redirections opened by the parent, and open()
+ * on a FIFO blocks until the other end is opened. That is only safe
+ * when every stage that may pair with it is already running: the last
+ * stage of a foreground pipeline. Earlier stages with redirections
+ * (`wc -l < fifo | tool > fifo`) and background jobs are forked, so
+ * the open happens in the child.
+ */
+bool	can_spawn(t_cmds *cmd, t_shell *shell)
+{
+	if (!cmd->str[0] || is_builtin(cmd))
+		return (false);
+	if ((cmd->next || shell->bg) && has_redirections(cmd))
+		return (false);
+	if (cmd->path || is_unresolved(cmd))
+		return (true);
+	return (ft_strchr(cmd->str[0], '/') && access(cmd->str[0], F_OK) == 0);
+}
+
+/**
+ * @brief Prepare spawn attributes for a stage
+ * @param attr Spawn attributes to initialize
+ * @param shell Shell state describing the pipeline being launched
+ *
+ * No file actions are needed: pipe ends and the saved stdin/stdout are
+ * all close-on-exec (see ft_pipe and ft_dup), so the child only keeps
+ * stdin/stdout/stderr. SIGINT and SIGQUIT get their default action
+ * back, as a forked child would after resetting its signal handlers.
+ * Background stages join the job's process group (see job_pgrp).
+ */
+static void	init_spawn(posix_spawnattr_t *attr, t_shell *shell)
+{
+	sigset_t	sigs;
+	short		flags;
+
+	posix_spawnattr_init(attr);
+	sigemptyset(&sigs);
+	sigaddset(&sigs, SIGINT);
+	sigaddset(&sigs, SIGQUIT);
+	posix_spawnattr_setsigdefault(attr, &sigs);
+	flags = POSIX_SPAWN_SETSIGDEF;
+	if (shell->bg)
+	{
+		posix_spawnattr_setpgroup(attr, shell->pgid);
+		flags |= POSIX_SPAWN_SETPGROUP;
+	}
+	posix_spawnattr_setflags(attr, flags);
+}
+
+/**
+ * @brief Launch an external command with posix_spawn()
+ * @param cmd Command structure containing the command and its arguments
+ * @param shell Shell state for environment access
+ * @return Process ID of the child, or -1 if it could not be started
+ *
+ * posix_spawn() avoids copying the parent's page tables, which becomes
+ * the dominant launch cost once the environment and history grow.
+ * On failure the diagnostic matches execute_currdir(): exit status 127
+ * for missing files, 126 otherwise.
+ */
+static pid_t	ft_spawn(t_cmds *cmd, t_shell *shell)
+{
+	posix_spawnattr_t	attr;
+	pid_t				pid;
+	char				*path;
+	int					ret;
+
+	path = cmd->path;
+	if (!path)
+		path = cmd->str[0];
+	init_spawn(&attr, shell);
+	ret = posix_spawn(&pid, path, NULL, &attr, cmd->str,
+			env_envp(shell));
+	posix_spawnattr_destroy(&attr);
+	if (ret == 0)
+		return (pid);
+	diag("minishell: %s: %s\n", cmd->str[0], strerror(ret));
+	cmd->exit_status = 126;
+	if (ret == ENOENT)
+		cmd->exit_status = 127;
+	return (-1);
+}
+
+/**
+ * @brief Launch one pipeline stage from the parent without forking
+ * @param cmd Current command in the pipeline (pipes already created)
+ * @param prev_fd Read end of the previous pipe (or -1 for first)
+ * @param shell Shell state for environment and configuration
+ *
+ * Redirections are applied by handle_redirections() on the live fd
+ * table, so the parent wires the pipe ends, redirections and the
+ * heredoc body (a memfd or pipe, see heredoc_stdin) onto its own
+ * stdin/stdout, spawns the child (which inherits them), and then
+ * restores its stdio exactly like single_cmd() does. Opening them here
+ * may block (a FIFO waits for its peer); can_spawn() only sends stages
+ * here when that cannot stall the rest of the pipeline.
+ *
+ * Stages that are not started get cmd->pid = -1 and their status in
+ * cmd->exit_status: 1 for a failed redirection, 127 for an unknown
+ * command.
+ */
+void	spawn_stage(t_cmds *cmd, int prev_fd, t_shell *shell)
+{
+	int	fds[2];
+
+	fds[0] = ft_dup(STDIN);
+	fds[1] = ft_dup(STDOUT);
+	if (prev_fd != -1)
+		dup2(prev_fd, STDIN);
+	if (cmd->next)
+		dup2(cmd->pipefd[1], STDOUT);
+	cmd->pid = -1;
+	cmd->exit_status = 1;
+	if (handle_redirections(cmd, shell) && heredoc_stdin(cmd))
+	{
+		if (is_unresolved(cmd))
+		{
+			cmd_not_found(cmd);
+			cmd->exit_status = 127;
+		}
+		else
+			cmd->pid = ft_spawn(cmd, shell);
+	}
+	job_pgrp(shell, cmd->pid);
+	ft_dup2(fds[0], STDIN);
+	ft_dup2(fds[1], STDOUT);
+}
@@ -0,0 +1,136 @@
+#include "minishell.h"
+#include "libft.h"
+#include <errno.h>
+#include <sys/sendfile.h>
+
+#define COPY_CHUNK 1048576
+
+/**
+ * @brief Check if a pipeline stage only copies one input to its output
+ * @param cmd Command structure after resolve_cmds()
+ * @param shell Shell state containing the command list
+ * @return true for the system `cat` with no options and at most one
+ *         file operand, in a pipeline of two or more stages
+ *
+ * Such stages (`< bigfile cat | ...`, `cat bigfile | ...`) are served
+ * by a forked helper moving data in the kernel instead of exec'ing cat.
+ * Only /bin/cat and /usr/bin/cat qualify: a `cat` wrapper found
+ * earlier in PATH keeps its own behaviour. A lone `cat file` has
+ * nothing to gain from the helper and is exec'd as usual.
+ */
+bool	is_copy_stage(t_cmds *cmd, t_shell *shell)
+{
+	if (!shell->cmds->next || !cmd->path
+		|| ft_strncmp(cmd->str[0], "cat", 4) != 0)
+		return (false);
+	if (ft_strncmp(cmd->path, "/bin/cat", 9) != 0
+		&& ft_strncmp(cmd->path, "/usr/bin/cat", 13) != 0)
+		return (false);
+	if (!cmd->str[1])
+		return (true);
+	return (cmd->str[2] == NULL && cmd->str[1][0] != '-');
+}
+
+/**
+ * @brief Move one chunk of data from in to out
+ * @param in Source file descriptor
+ * @param out Destination file descriptor
+ * @param mode Current strategy, downgraded when the kernel refuses one
+ * @return Number of bytes moved, 0 on EOF, -1 on error
+ *
+ * Strategies, fastest first:
+ * 0. splice(): zero-copy, needs a pipe on either side
+ * 1. sendfile(): zero-copy from a regular (mmap-able) file
+ * 2. read()/write() through a stack buffer
+ */
+static ssize_t	move_chunk(int in, int out, int *mode)
+{
+	char	buf[65536];
+	ssize_t	n;
+	ssize_t	done;
+	ssize_t	w;
+
+	if (*mode == 0)
+		n = splice(in, NULL, out, NULL, COPY_CHUNK, SPLICE_F_MOVE);
+	if (*mode == 0 && (n >= 0 || errno != EINVAL))
+		return (n);
+	*mode += (*mode == 0);
+	if (*mode == 1)
+		n = sendfile(out, in, NULL, COPY_CHUNK);
+	if (*mode == 1 && (n >= 0 || errno != EINVAL))
+		return (n);
+	*mode = 2;
+	n = read(in, buf, sizeof(buf));
+	done = 0;
+	while (n > 0 && done < n)
+	{
+		w = write(out, buf + done, n - done);
+		if (w == -1)
+			return (-1);
+		done += w;
+	}
+	return (n);
+}
+
+/**
+ * @brief Copy everything from in to out, retrying interrupted calls
+ * @param in Source file descriptor
+ * @param out Destination file descriptor
+ * @return 0 on success, -1 on error (errno set)
+ */
+static int	copy_fd(int in, int out)
+{
+	ssize_t	n;
+	int		mode;
+
+	mode = 0;
+	n = 1;
+	while (n != 0)
+	{
+		n = move_chunk(in, out, &mode);
+		if (n == -1 && errno != EINTR)
+			return (-1);
+	}
+	return (0);
+}
+
+/**
+ * @brief Launch a copy-only stage as a helper process without exec
+ * @param cmd Copy stage as detected by is_copy_stage()
+ * @param prev_fd Read end of the previous pipe (or -1 for first)
+ * @param shell Shell state containing the command list
+ *
+ * The helper is wired exactly like a forked built-in, then streams its
+ * input (the file operand, or stdin after redirections) to stdout.
+ * Diagnostics and exit status follow cat: "cat: file: reason", 1.
+ */
+void	copy_stage(t_cmds *cmd, int prev_fd, t_shell *shell)
+{
+	int	in;
+
+	cmd->pid = ft_fork();
+	job_pgrp(shell, cmd->pid);
+	if (cmd->pid != 0)
+		return ;
+	signal(SIGINT, SIG_DFL);
+	signal(SIGQUIT, SIG_DFL);
+	signal(SIGPIPE, SIG_DFL);
+	if (prev_fd != -1)
+		dup2(prev_fd, STDIN);
+	if (cmd->next)
+		dup2(cmd->pipefd[1], STDOUT);
+	close_pipeline(shell);
+	if (!handle_redirections(cmd, shell) || !heredoc_stdin(cmd))
+		exit(1);
+	fd_compact(shell);
+	in = STDIN;
+	if (cmd->str[1])
+		in = open(cmd->str[1], O_RDONLY);
+	if (in != -1 && copy_fd(in, STDOUT) == 0)
+		exit(0);
+	if (cmd->str[1])
+		diag("cat: %s: %m\n", cmd->str[1]);
+	else
+		diag("cat: %m\n");
+	exit(1);
+}
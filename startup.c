@@ -0,0 +1,100 @@
+#include "minishell.h"
+#include "libft.h"
+#include <time.h>
+
+/**
+ * @brief Remove a leading --startup-trace flag from main()'s arguments
+ * @param ac Argument count of main()
+ * @param av Argument vector of main() (shifted in place)
+ * @return true if the flag was present
+ */
+static bool	startup_flag(int *ac, char **av)
+{
+	int	i;
+
+	if (*ac < 2 || ft_strncmp(av[1], "--startup-trace", 16) != 0)
+		return (false);
+	i = 1;
+	while (i < *ac)
+	{
+		av[i] = av[i + 1];
+		i++;
+	}
+	(*ac)--;
+	return (true);
+}
+
+/**
+ * @brief Print the time spent in one init phase and start the next one
+ * @param name Phase name, or NULL to print the total since start
+ * @param start Time the first phase began
+ * @param prev Time the current phase began (updated)
+ *
+ * Lines look like "minishell: startup: env\t42us" on stderr.
+ */
+static void	startup_phase(const char *name, struct timespec *start,
+		struct timespec *prev)
+{
+	struct timespec	now;
+	struct timespec	*from;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	from = prev;
+	if (!name)
+	{
+		from = start;
+		name = "total";
+	}
+	diag("minishell: startup: %s\t%ldus\n", name,
+		(now.tv_sec - from->tv_sec) * 1000000L
+		+ (now.tv_nsec - from->tv_nsec) / 1000);
+	*prev = now;
+}
+
+/**
+ * @brief Build all per-process shell state once, before the first line
+ * @param shell Zero-initialized shell state
+ * @param ac Argument count of main()
+ * @param av Argument vector of main()
+ * @param envp Environment of the process
+ * @return Argument count left for run_batch() once flags are removed
+ *
+ * Phases, each timed when started with --startup-trace:
+ * 1. env:  index envp into the environment store
+ * 2. path: split PATH into the cached directory list
+ * 3. envp: build the envp array handed to execve()/posix_spawn()
+ * 4. pwd:  cache the logical working directory
+ * Nothing here is re-derived per command afterwards: each cache is
+ * only rebuilt when the variable or directory it mirrors changes.
+ */
+int	shell_init(t_shell *shell, int ac, char **av, char **envp)
+{
+	struct timespec	start;
+	struct timespec	prev;
+	bool			trace;
+
+	trace = startup_flag(&ac, av);
+	shell->out.fd = STDOUT;
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	prev = start;
+	env_init(shell, envp);
+	trace_init(shell);
+	shell->fd_check = (env_get(shell, "MINISHELL_FDCHECK") != NULL);
+	if (env_get(shell, "MINISHELL_PIPE_SIZE"))
+		shell->opts |= OPT_BIGPIPE;
+	if (trace)
+		startup_phase("env", &start, &prev);
+	path_dirs(shell);
+	if (trace)
+		startup_phase("path", &start, &prev);
+	env_envp(shell);
+	if (trace)
+		startup_phase("envp", &start, &prev);
+	shell_pwd(shell);
+	if (trace)
+	{
+		startup_phase("pwd", &start, &prev);
+		startup_phase(NULL, &start, &prev);
+	}
+	return (ac);
+}
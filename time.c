@@ -0,0 +1,110 @@
+#include "minishell.h"
+#include "libft.h"
+#include <sys/resource.h>
+#include <time.h>
+
+/**
+ * @brief Strip a leading `time [-s]` reserved word from the pipeline
+ * @param shell Shell state containing the parsed command list
+ * @return true if the pipeline has to be timed
+ *
+ * `time` is only recognized as the first word of the first command.
+ * With -s, shell->time_stages asks for a per-stage breakdown as well.
+ */
+bool	time_prefix(t_shell *shell)
+{
+	char	**str;
+	int		skip;
+	int		i;
+
+	str = shell->cmds->str;
+	if (!str[0] || ft_strncmp(str[0], "time", 5) != 0)
+		return (false);
+	shell->time_stages = (str[1] && ft_strncmp(str[1], "-s", 3) == 0);
+	skip = 1 + shell->time_stages;
+	i = 0;
+	while (i < skip)
+		free(str[i++]);
+	i = 0;
+	while (str[i + skip])
+	{
+		str[i] = str[i + skip];
+		i++;
+	}
+	str[i] = NULL;
+	return (true);
+}
+
+/**
+ * @brief Convert a struct timeval difference to microseconds
+ * @param a Later time
+ * @param b Earlier time
+ * @return a - b in microseconds
+ */
+static long	tv_diff(struct timeval a, struct timeval b)
+{
+	return ((a.tv_sec - b.tv_sec) * 1000000L + (a.tv_usec - b.tv_usec));
+}
+
+/**
+ * @brief Print user/sys time of every stage, from its wait4() rusage
+ * @param shell Shell state containing the executed command list
+ *
+ * Stages that ran in the shell itself (pid -1) are accounted in the
+ * shell's own usage and report zero here.
+ */
+static void	report_stages(t_shell *shell)
+{
+	struct timeval	zero;
+	t_cmds			*curr;
+	int				i;
+
+	ft_bzero(&zero, sizeof(zero));
+	curr = shell->cmds;
+	i = 1;
+	while (curr)
+	{
+		if (curr->str[0])
+			diag("stage %d (%s):\tuser %T\tsys %T\n", i++, curr->str[0],
+				tv_diff(curr->rusage.ru_utime, zero),
+				tv_diff(curr->rusage.ru_stime, zero));
+		else
+			diag("stage %d:\tuser %T\tsys %T\n", i++,
+				tv_diff(curr->rusage.ru_utime, zero),
+				tv_diff(curr->rusage.ru_stime, zero));
+		curr = curr->next;
+	}
+}
+
+/**
+ * @brief Execute a pipeline and report its real/user/sys time
+ * @param shell Shell state with the `time` prefix already stripped
+ *
+ * User and sys times cover the shell itself (built-ins run in the
+ * parent) and every child reaped meanwhile, like bash does.
+ */
+void	time_pipeline(t_shell *shell)
+{
+	struct timespec	t[2];
+	struct rusage	self[2];
+	struct rusage	kids[2];
+	bool			stages;
+
+	stages = shell->time_stages;
+	clock_gettime(CLOCK_MONOTONIC, &t[0]);
+	getrusage(RUSAGE_SELF, &self[0]);
+	getrusage(RUSAGE_CHILDREN, &kids[0]);
+	execute(shell);
+	clock_gettime(CLOCK_MONOTONIC, &t[1]);
+	getrusage(RUSAGE_SELF, &self[1]);
+	getrusage(RUSAGE_CHILDREN, &kids[1]);
+	if (stages)
+		report_stages(shell);
+	diag("\nreal\t%T\nuser\t%T\nsys\t%T\n",
+		(t[1].tv_sec - t[0].tv_sec) * 1000000L
+		+ (t[1].tv_nsec - t[0].tv_nsec) / 1000,
+		tv_diff(self[1].ru_utime, self[0].ru_utime)
+		+ tv_diff(kids[1].ru_utime, kids[0].ru_utime),
+		tv_diff(self[1].ru_stime, self[0].ru_stime)
+		+ tv_diff(kids[1].ru_stime, kids[0].ru_stime));
+}
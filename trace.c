@@ -0,0 +1,156 @@
+#include "minishell.h"
+#include "libft.h"
+#include <time.h>
+
+/**
+ * @brief Open the trace log named by MINISHELL_TRACE, if any
+ * @param shell Shell state receiving the trace fd (-1 when disabled)
+ *
+ * The log is opened for appending, so several shells can share it;
+ * each record leaves in a single write() (see trace_line).
+ */
+void	trace_init(t_shell *shell)
+{
+	char	*path;
+
+	shell->trace_fd = -1;
+	path = env_get(shell, "MINISHELL_TRACE");
+	if (!path || !*path)
+		return ;
+	shell->trace_fd = open(path, O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC,
+			0644);
+	if (shell->trace_fd == -1)
+		diag("minishell: MINISHELL_TRACE: %s: %m\n", path);
+}
+
+/**
+ * @brief Timestamp a phase when tracing is enabled
+ * @param shell Shell state holding the trace fd
+ * @return Monotonic time in nanoseconds, or 0 when tracing is off
+ *
+ * With tracing off this is a single comparison, so the stamps can sit
+ * on the hot path unconditionally.
+ */
+long	trace_now(t_shell *shell)
+{
+	struct timespec	ts;
+
+	if (shell->trace_fd == -1)
+		return (0);
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (ts.tv_sec * 1000000000L + ts.tv_nsec);
+}
+
+/**
+ * @brief Keep a copy of a stage's PATH for its trace record
+ * @param shell Shell state holding the trace fd and the arena
+ * @param path Path resolved for the stage, owned by the hash table
+ * @return Arena copy valid until the next command line, or NULL when
+ *         tracing is off or the stage has no path
+ *
+ * trace_line() runs after the whole pipeline, and a lastpipe stage
+ * such as `hash -r` or `export PATH=...` frees the table's entries
+ * before that: the record must not point into the table.
+ */
+const char	*trace_path(t_shell *shell, const char *path)
+{
+	size_t	len;
+
+	if (shell->trace_fd == -1 || !path)
+		return (NULL);
+	len = ft_strlen(path) + 1;
+	return (ft_memcpy(arena_alloc(&shell->arena, len), path, len));
+}
+
+/**
+ * @brief Append one "key=value" field to a trace record
+ * @param out Buffer writing to the trace log
+ * @param key Field name, including the leading separator
+ * @param value Field value
+ */
+static void	trace_field(t_outbuf *out, const char *key, long value)
+{
+	out_puts(out, key);
+	if (value < 0)
+	{
+		out_putc(out, '-');
+		value = -value;
+	}
+	out_putnbr(out, value, 0);
+}
+
+/**
+ * @brief Append the record of one pipeline stage
+ * @param out Buffer writing to the trace log
+ * @param shell Shell state with the line's phase stamps
+ * @param cmd Stage to describe
+ *
+ * Record format (one line, logfmt-style):
+ *   parse=T heredocs=T resolve=T fork=T exec=T reap=T pid=N status=N
+ *   cmd=NAME path=PATH
+ * T are CLOCK_MONOTONIC nanoseconds. fork is when the stage's launch
+ * began and exec when it returned (posix_spawn returns once the child
+ * has exec'd); reap is when its status was collected. Stages run in
+ * the shell have pid=-1 and reap=exec; background stages still running
+ * have reap=0 and status=-1.
+ */
+static void	trace_cmd(t_outbuf *out, t_shell *shell, t_cmds *cmd)
+{
+	long	reap;
+
+	reap = cmd->stamp.reap;
+	if (cmd->stamp.pid <= 0)
+		reap = cmd->stamp.exec;
+	trace_field(out, "parse=", shell->stamp[TR_PARSE]);
+	trace_field(out, " heredocs=", shell->stamp[TR_HEREDOCS]);
+	trace_field(out, " resolve=", shell->stamp[TR_RESOLVE]);
+	trace_field(out, " fork=", cmd->stamp.fork);
+	trace_field(out, " exec=", cmd->stamp.exec);
+	trace_field(out, " reap=", reap);
+	trace_field(out, " pid=", cmd->stamp.pid);
+	if (cmd->pid > 0)
+		trace_field(out, " status=", -1);
+	else
+		trace_field(out, " status=", cmd->exit_status);
+	out_puts(out, " cmd=");
+	if (cmd->str[0])
+		out_puts(out, cmd->str[0]);
+	out_puts(out, " path=");
+	if (cmd->stamp.path)
+		out_puts(out, cmd->stamp.path);
+	out_putc(out, '\n');
+}
+
+/**
+ * @brief Write the trace records of the command line just executed
+ * @param shell Shell state with the executed command list
+ *
+ * Each record is collected whole in a growable buffer (the output
+ * buffer's sink) and leaves in exactly one write(), however long its
+ * cmd and path are: with O_APPEND, records from concurrent shells
+ * sharing the log never interleave.
+ */
+void	trace_line(t_shell *shell)
+{
+	t_outbuf	out;
+	t_heredoc	rec;
+	t_cmds		*curr;
+
+	if (shell->trace_fd == -1)
+		return ;
+	out.len = 0;
+	out.fd = shell->trace_fd;
+	out.sink = &rec;
+	ft_bzero(&rec, sizeof(rec));
+	curr = shell->cmds;
+	while (curr)
+	{
+		rec.len = 0;
+		trace_cmd(&out, shell, curr);
+		out_flush(&out);
+		if (write(shell->trace_fd, rec.buf, rec.len) == -1)
+			break ;
+		curr = curr->next;
+	}
+	free(rec.buf);
+}